@@ -0,0 +1,33 @@
+#!/usr/bin/env python3
+
+# This script checks that the space-charge fields obtained when the species
+# with close velocities are solved together (warpx.self_fields_beta_tolerance)
+# are the same as those obtained with one Poisson solve per species (the output
+# of the reference test, which this test depends on).
+
+import os
+
+import numpy as np
+from openpmd_viewer import OpenPMDTimeSeries
+
+path = os.path.join("diags", "diag1")
+ts = OpenPMDTimeSeries(path)
+ts_reference = OpenPMDTimeSeries(os.path.join(os.getcwd() + "_reference", path))
+
+assert np.array_equal(ts.iterations, ts_reference.iterations)
+
+# The grouped solve uses the average of the velocities of the two relativistic
+# bunches, which differ by about 1e-9: the fields agree to much better than 1e-6
+# (Bz vanishes in both cases, since the bunches move along z)
+tolerance = 1e-6
+for iteration in ts.iterations:
+    for field in ["E", "B"]:
+        for coord in ["x", "y", "z"]:
+            F, _ = ts.get_field(field=field, coord=coord, iteration=iteration)
+            F_reference, _ = ts_reference.get_field(
+                field=field, coord=coord, iteration=iteration
+            )
+            error = np.max(np.abs(F - F_reference))
+            scale = np.max(np.abs(F_reference))
+            print(f"iteration {iteration}, {field}{coord}: error {error}, max {scale}")
+            assert error <= tolerance * scale
@@ -0,0 +1,74 @@
+#!/usr/bin/env python3
+
+# This script checks the self fields of two Gaussian bunches with the same
+# charge distribution, one relativistic and one at rest, which are computed
+# one after the other with the IGF (open boundaries) FFT solver. The Green
+# function depends on gamma: if it were not computed again for the bunch at
+# rest, the field of this bunch would be that of the relativistic one.
+
+import os
+
+import numpy as np
+from openpmd_viewer import OpenPMDTimeSeries
+from scipy.constants import epsilon_0, pi
+from scipy.special import erf
+
+sigma = 1e-6
+Q = -1e-12
+
+
+def E_relativistic(rho, z):
+    """Radial field of the relativistic bunch (gamma*sigma >> r):
+    field of a line charge with the longitudinal profile of the bunch"""
+    line_density = Q / (np.sqrt(2 * pi) * sigma) * np.exp(-(z**2) / (2 * sigma**2))
+    return (
+        line_density
+        / (2 * pi * epsilon_0 * rho)
+        * (1 - np.exp(-(rho**2) / (2 * sigma**2)))
+    )
+
+
+def E_at_rest(r):
+    """Radial (Coulomb) field of the spherical Gaussian bunch at rest"""
+    return (
+        Q
+        / (4 * pi * epsilon_0 * r**2)
+        * (
+            erf(r / (np.sqrt(2) * sigma))
+            - np.sqrt(2 / pi) * r / sigma * np.exp(-(r**2) / (2 * sigma**2))
+        )
+    )
+
+
+path = os.path.join("diags", "diag2")
+ts = OpenPMDTimeSeries(path)
+
+for coord in ["x", "y"]:
+    E, info = ts.get_field(field="E", coord=coord, iteration=0, plot=False)
+    # Order the axes of the field as x, y, z
+    axes = [info.axes[i] for i in range(3)]
+    E = np.transpose(E, [axes.index(a) for a in ["x", "y", "z"]])
+
+    # Take the field along the transverse axis `coord`, on the grid points closest to it
+    grid = {a: getattr(info, a) for a in ["x", "y", "z"]}
+    i0 = {a: np.argmin(np.abs(grid[a])) for a in ["x", "y", "z"]}
+    if coord == "x":
+        E_warpx = E[:, i0["y"], i0["z"]]
+        x, y, z = grid["x"], grid["y"][i0["y"]], grid["z"][i0["z"]]
+        transverse = x
+    else:
+        E_warpx = E[i0["x"], :, i0["z"]]
+        x, y, z = grid["x"][i0["x"]], grid["y"], grid["z"][i0["z"]]
+        transverse = y
+
+    rho = np.sqrt(x**2 + y**2)
+    r = np.sqrt(x**2 + y**2 + z**2)
+    E_theory = E_relativistic(rho, z) * transverse / rho + E_at_rest(r) * transverse / r
+
+    # Compare away from the center, where the field vanishes, and from the boundaries
+    select = (np.abs(transverse) >= sigma) & (np.abs(transverse) <= 4 * sigma)
+    print(
+        f"max relative error of E{coord}: ",
+        np.max(np.abs(E_warpx[select] - E_theory[select]) / np.abs(E_theory[select])),
+    )
+    assert np.allclose(E_warpx[select], E_theory[select], rtol=0.03, atol=0)
@@ -13,10 +13,12 @@
 # per rank, normalized to the maximum cost over all ranks) extracted from the
 # reduced diagnostic is compared before and after the load balance step; the test
 # ensures that efficiency, measured via the reduced diagnostic, improves after
-# the load balance step.
+# the load balance step, and that boxes were moved. With the timers, the test
+# also checks that the costs of the kernels add up to the cost of each box.
 
 # Possible running time: ~ 1 s
 
+import re
 import sys
 
 import numpy as np
@@ -40,10 +42,26 @@ with open("./diags/reducedfiles/LBC.txt") as f:
 
 # From data header, data layout is:
 #     [step, time,
-#      cost_box_0, proc_box_0, lev_box_0, i_low_box_0, j_low_box_0, k_low_box_0(, gpu_ID_box_0 if GPU run), hostname_box_0,
-#      cost_box_1, proc_box_1, lev_box_1, i_low_box_1, j_low_box_1, k_low_box_1(, gpu_ID_box_1 if GPU run), hostname_box_1,
+#      cost_box_0, proc_box_0, lev_box_0, i_low_box_0, j_low_box_0, k_low_box_0, num_cells_0, num_macro_particles_0(, gpu_ID_box_0 if GPU run),
+#           cost_gather_push_box_0, cost_deposition_box_0, cost_field_solve_box_0, cost_collisions_box_0, cost_particle_creation_box_0, hostname_box_0,
+#      cost_box_1, proc_box_1, lev_box_1, i_low_box_1, j_low_box_1, k_low_box_1, num_cells_1, num_macro_particles_1(, gpu_ID_box_1 if GPU run),
+#           cost_gather_push_box_1, cost_deposition_box_1, cost_field_solve_box_1, cost_collisions_box_1, cost_particle_creation_box_1, hostname_box_1,
 #      ...
-#      cost_box_n, proc_box_n, lev_box_n, i_low_box_n, j_low_box_n, k_low_box_n(, gpu_ID_box_n if GPU run), hostname_box_n]
+#      cost_box_n, proc_box_n, lev_box_n, i_low_box_n, j_low_box_n, k_low_box_n, num_cells_n, num_macro_particles_n(, gpu_ID_box_n if GPU run),
+#           cost_gather_push_box_n, cost_deposition_box_n, cost_field_solve_box_n, cost_collisions_box_n, cost_particle_creation_box_n, hostname_box_n]
+field_names = [
+    re.sub(r"^\[\d+\]|_0\(\)$", "", w) for w in h.split()[2 : 2 + n_data_fields]
+]
+kernel_fields = [
+    field_names.index(name)
+    for name in [
+        "cost_gather_push_box",
+        "cost_deposition_box",
+        "cost_field_solve_box",
+        "cost_collisions_box",
+        "cost_particle_creation_box",
+    ]
+]
 
 
 # Function to get efficiency at an iteration i
@@ -71,3 +89,26 @@ print("load balance efficiency (after load balance): ", efficiency_after)
 # The load balanced case is expected to be more efficient
 # than non-load balanced case
 assert efficiency_before < efficiency_after
+
+# The load balance step actually moved boxes to other ranks
+ranks_before, ranks_after = data[1, 1::n_data_fields], data[2, 1::n_data_fields]
+n_moved = np.count_nonzero(ranks_before != ranks_after)
+print("number of boxes moved by the load balance step: ", n_moved)
+assert n_moved > 0
+
+# With the timers, each kernel adds the time it spends on a box both to the
+# cost of the box and to its own column: the columns must add up to the cost
+with open("./warpx_used_inputs", "r") as f:
+    warpx_used_inputs = f.read()
+if re.search(
+    r"algo.load_balance_costs_update\s*=\s*timers", warpx_used_inputs, re.IGNORECASE
+):
+    costs = data[:, 0::n_data_fields]
+    kernel_costs = sum(data[:, k::n_data_fields] for k in kernel_fields)
+    print("max cost of a box: ", np.max(costs))
+    print(
+        "max difference between the cost and the sum of the kernel costs: ",
+        np.max(np.abs(costs - kernel_costs)),
+    )
+    assert np.all(kernel_costs > 0.0)
+    assert np.allclose(kernel_costs, costs, rtol=1.0e-6, atol=0.0)
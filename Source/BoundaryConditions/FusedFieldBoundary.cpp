@@ -0,0 +1,57 @@
+/* Copyright 2025 The WarpX Community
+ *
+ * This file is part of WarpX.
+ *
+ * License: BSD-3-Clause-LBNL
+ */
+#include "FusedFieldBoundary.H"
+
+#include "BoundaryConditions/WarpX_PEC.H"
+
+#include <AMReX_Box.H>
+#include <AMReX_IntVect.H>
+#include <AMReX_MFIter.H>
+#include <AMReX_MultiFab.H>
+
+bool
+FusedFieldBoundary::CanApplyOnTiles (amrex::MultiFab const& mf) const
+{
+    const auto is_mirror = [](const FieldBoundaryType fbt) {
+        return fbt == FieldBoundaryType::PEC || fbt == FieldBoundaryType::PMC;
+    };
+
+    for (amrex::MFIter mfi(mf, amrex::TilingIfNotGPU()); mfi.isValid(); ++mfi) {
+        const amrex::Box tile = mfi.tilebox(amrex::IntVect::TheCellVector());
+        for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+            // The mirror locations of the guard cells are up to ng_fieldgather
+            // grid points inside the domain
+            const bool at_mirror_boundary =
+                (is_mirror(field_boundary_lo[idim]) && tile.smallEnd(idim) == domain_box.smallEnd(idim)) ||
+                (is_mirror(field_boundary_hi[idim]) && tile.bigEnd(idim) == domain_box.bigEnd(idim));
+            if (at_mirror_boundary && tile.length(idim) <= ng_fieldgather[idim]) { return false; }
+        }
+    }
+    return true;
+}
+
+void
+FusedFieldBoundary::ApplyToEfieldOnTile (amrex::MFIter const& mfi,
+                                         ablastr::fields::VectorField const& Efield) const
+{
+    // Same order as in WarpX::ApplyEfieldBoundary
+    PEC::ApplyPECtoEfieldOnTile(mfi, Efield, field_boundary_lo, field_boundary_hi,
+                                FieldBoundaryType::PEC, ng_fieldgather, domain_box);
+    PEC::ApplyPECtoBfieldOnTile(mfi, Efield, field_boundary_lo, field_boundary_hi,
+                                FieldBoundaryType::PMC, ng_fieldgather, domain_box);
+}
+
+void
+FusedFieldBoundary::ApplyToBfieldOnTile (amrex::MFIter const& mfi,
+                                         ablastr::fields::VectorField const& Bfield) const
+{
+    // Same order as in WarpX::ApplyBfieldBoundary
+    PEC::ApplyPECtoBfieldOnTile(mfi, Bfield, field_boundary_lo, field_boundary_hi,
+                                FieldBoundaryType::PEC, ng_fieldgather, domain_box);
+    PEC::ApplyPECtoEfieldOnTile(mfi, Bfield, field_boundary_lo, field_boundary_hi,
+                                FieldBoundaryType::PMC, ng_fieldgather, domain_box);
+}
@@ -1,4 +1,5 @@
 #include "WarpX.H"
+#include "BoundaryConditions/FusedFieldBoundary.H"
 #include "BoundaryConditions/PEC_Insulator.H"
 #include "BoundaryConditions/PML.H"
 #include "FieldSolver/FiniteDifferenceSolver/FiniteDifferenceSolver.H"
@@ -16,6 +17,7 @@
 #include <algorithm>
 #include <array>
 #include <memory>
+#include <optional>
 
 using namespace amrex;
 using namespace amrex::literals;
@@ -49,17 +51,20 @@ namespace
 
 }
 
-void WarpX::ApplyEfieldBoundary(const int lev, PatchType patch_type, amrex::Real time)
+void WarpX::ApplyEfieldBoundary(const int lev, PatchType patch_type, amrex::Real time,
+                                const bool fused_boundaries_applied)
 {
     using ablastr::fields::Direction;
 
     if (::isAnyBoundary<FieldBoundaryType::PEC>(field_boundary_lo, field_boundary_hi)) {
         if (patch_type == PatchType::fine) {
-            PEC::ApplyPECtoEfield(
+            if (!fused_boundaries_applied) {
+                PEC::ApplyPECtoEfield(
                     m_fields.get_alldirs(FieldType::Efield_fp, lev),
                     field_boundary_lo, field_boundary_hi, FieldBoundaryType::PEC,
                     get_ng_fieldgather(), Geom(lev),
                     lev, patch_type, ref_ratio);
+            }
             if (::isAnyBoundary<FieldBoundaryType::PML>(field_boundary_lo, field_boundary_hi)) {
                 // apply pec on split E-fields in PML region
                 const bool split_pml_field = true;
@@ -71,11 +76,13 @@ void WarpX::ApplyEfieldBoundary(const int lev, PatchType patch_type, amrex::Real
                     split_pml_field);
             }
         } else {
-            PEC::ApplyPECtoEfield(
+            if (!fused_boundaries_applied) {
+                PEC::ApplyPECtoEfield(
                     m_fields.get_alldirs(FieldType::Efield_cp, lev),
                     field_boundary_lo, field_boundary_hi, FieldBoundaryType::PEC,
                     get_ng_fieldgather(), Geom(lev),
                     lev, patch_type, ref_ratio);
+            }
             if (::isAnyBoundary<FieldBoundaryType::PML>(field_boundary_lo, field_boundary_hi)) {
                 // apply pec on split E-fields in PML region
                 const bool split_pml_field = true;
@@ -91,11 +98,13 @@ void WarpX::ApplyEfieldBoundary(const int lev, PatchType patch_type, amrex::Real
 
     if (::isAnyBoundary<FieldBoundaryType::PMC>(field_boundary_lo, field_boundary_hi)) {
         if (patch_type == PatchType::fine) {
-            PEC::ApplyPECtoBfield(
+            if (!fused_boundaries_applied) {
+                PEC::ApplyPECtoBfield(
                     m_fields.get_alldirs(FieldType::Efield_fp, lev),
                     field_boundary_lo, field_boundary_hi, FieldBoundaryType::PMC,
                     get_ng_fieldgather(), Geom(lev),
                     lev, patch_type, ref_ratio);
+            }
             if (::isAnyBoundary<FieldBoundaryType::PML>(field_boundary_lo, field_boundary_hi)) {
                 // apply pec on split E-fields in PML region
                 const bool split_pml_field = true;
@@ -107,11 +116,13 @@ void WarpX::ApplyEfieldBoundary(const int lev, PatchType patch_type, amrex::Real
                     split_pml_field);
             }
         } else {
-            PEC::ApplyPECtoBfield(
+            if (!fused_boundaries_applied) {
+                PEC::ApplyPECtoBfield(
                     m_fields.get_alldirs(FieldType::Efield_cp, lev),
                     field_boundary_lo, field_boundary_hi, FieldBoundaryType::PMC,
                     get_ng_fieldgather(), Geom(lev),
                     lev, patch_type, ref_ratio);
+            }
             if (::isAnyBoundary<FieldBoundaryType::PML>(field_boundary_lo, field_boundary_hi)) {
                 // apply pec on split E-fields in PML region
                 const bool split_pml_field = true;
@@ -178,11 +189,15 @@ void WarpX::ApplyEfieldBoundary(const int lev, PatchType patch_type, amrex::Real
 #endif
 }
 
-void WarpX::ApplyBfieldBoundary (const int lev, PatchType patch_type, DtType a_dt_type, amrex::Real time)
+void WarpX::ApplyBfieldBoundary (const int lev, PatchType patch_type, DtType a_dt_type, amrex::Real time,
+                                 const bool fused_boundaries_applied)
 {
     using ablastr::fields::Direction;
 
-    if (::isAnyBoundary<FieldBoundaryType::PEC>(field_boundary_lo, field_boundary_hi)) {
+    // The PEC, PMC and Silver-Mueller boundaries of the regular B field
+    // may have been applied by the field solver (see GetFusedFieldBoundary)
+    if (!fused_boundaries_applied &&
+        ::isAnyBoundary<FieldBoundaryType::PEC>(field_boundary_lo, field_boundary_hi)) {
         if (patch_type == PatchType::fine) {
             PEC::ApplyPECtoBfield(
                 m_fields.get_alldirs(FieldType::Bfield_fp, lev),
@@ -198,7 +213,8 @@ void WarpX::ApplyBfieldBoundary (const int lev, PatchType patch_type, DtType a_d
         }
     }
 
-    if (::isAnyBoundary<FieldBoundaryType::PMC>(field_boundary_lo, field_boundary_hi)) {
+    if (!fused_boundaries_applied &&
+        ::isAnyBoundary<FieldBoundaryType::PMC>(field_boundary_lo, field_boundary_hi)) {
         if (patch_type == PatchType::fine) {
             PEC::ApplyPECtoEfield(
                 m_fields.get_alldirs(FieldType::Bfield_fp, lev),
@@ -237,7 +253,7 @@ void WarpX::ApplyBfieldBoundary (const int lev, PatchType patch_type, DtType a_d
     // Silver-Mueller boundaries are only applied on the first half-push of B
     // This is because the formula used for Silver-Mueller assumes that
     // E and B are staggered in time, which is only true after the first half-push
-    if (lev == 0) {
+    if (lev == 0 && !fused_boundaries_applied) {
         if (a_dt_type == DtType::FirstHalf) {
             if(::isAnyBoundary<FieldBoundaryType::Absorbing_SilverMueller>(field_boundary_lo, field_boundary_hi)){
                 auto Efield_fp = m_fields.get_mr_levels_alldirs(FieldType::Efield_fp, max_level);
@@ -263,6 +279,51 @@ void WarpX::ApplyBfieldBoundary (const int lev, PatchType patch_type, DtType a_d
 #endif
 }
 
+std::optional<FusedFieldBoundary>
+WarpX::GetFusedFieldBoundary (const int lev, PatchType patch_type, DtType a_dt_type) const
+{
+    if (!m_fdtd_fused_boundaries) { return std::nullopt; }
+
+#ifdef WARPX_DIM_RZ
+    // The boundary conditions on the axis are applied after the PEC boundaries
+    amrex::ignore_unused(lev, patch_type, a_dt_type);
+    return std::nullopt;
+#else
+    // The boundaries are applied in the tile loops of the Cartesian Yee and CKC solvers
+    if (electromagnetic_solver_id != ElectromagneticSolverAlgo::Yee &&
+        electromagnetic_solver_id != ElectromagneticSolverAlgo::CKC) {
+        return std::nullopt;
+    }
+
+    const bool silver_mueller = lev == 0 && patch_type == PatchType::fine &&
+        a_dt_type == DtType::FirstHalf &&
+        ::isAnyBoundary<FieldBoundaryType::Absorbing_SilverMueller>(field_boundary_lo, field_boundary_hi);
+    if (!silver_mueller &&
+        !::isAnyBoundary<FieldBoundaryType::PEC>(field_boundary_lo, field_boundary_hi) &&
+        !::isAnyBoundary<FieldBoundaryType::PMC>(field_boundary_lo, field_boundary_hi)) {
+        return std::nullopt;
+    }
+
+    FusedFieldBoundary fused_bc;
+    fused_bc.field_boundary_lo = field_boundary_lo;
+    fused_bc.field_boundary_hi = field_boundary_hi;
+    fused_bc.domain_box = Geom(lev).Domain();
+    if (patch_type == PatchType::coarse && (lev > 0)) {
+        fused_bc.domain_box.coarsen(ref_ratio[lev-1]);
+    }
+    fused_bc.ng_fieldgather = get_ng_fieldgather();
+    fused_bc.silver_mueller = silver_mueller;
+    fused_bc.silver_mueller_dt = dt[lev];
+
+    const FieldType efield = (patch_type == PatchType::fine) ? FieldType::Efield_fp : FieldType::Efield_cp;
+    if (!fused_bc.CanApplyOnTiles(*m_fields.get(efield, ablastr::fields::Direction{0}, lev))) {
+        return std::nullopt;
+    }
+
+    return fused_bc;
+#endif
+}
+
 void WarpX::ApplyRhofieldBoundary (const int lev, MultiFab* rho,
                                    PatchType patch_type)
 {
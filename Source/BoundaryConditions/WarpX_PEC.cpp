@@ -16,6 +16,9 @@
 #include <AMReX_MultiFab.H>
 #include <AMReX_REAL.H>
 #include <AMReX_SPACE.H>
+#include <AMReX_Vector.H>
+
+#include <algorithm>
 
 using namespace amrex;
 using namespace amrex::literals;
@@ -47,6 +50,51 @@ namespace
                              : (ijk_vec[idim] - (dom_hi[idim] + is_nodal[idim])));
     }
 
+    /**
+     * \brief Disjoint parts of the box `tb` that contain all the grid points of `tb` that
+     *        are on or beyond a boundary of type `bc_type`, i.e. the points for which
+     *        get_cell_count_to_boundary is non-negative in a direction with such a boundary.
+     *        The other points are not modified by SetEfieldOnPEC and SetBfieldOnPEC.
+     *
+     * \param[in] tb              Box to split, with the staggering of the field
+     * \param[in] is_nodal        Staggering of the field
+     * \param[in] dom_lo, dom_hi  Domain boundaries
+     * \param[in] fbndry_lo       Field boundary type at the lower boundaries
+     * \param[in] fbndry_hi       Field boundary type at the upper boundaries
+     * \param[in] bc_type         Boundary type of interest
+     *
+     * \returns the boxes on or beyond the boundaries (possibly none)
+     */
+    amrex::Vector<amrex::Box> get_boxes_on_boundary (amrex::Box tb,
+        const amrex::IntVect& is_nodal,
+        const amrex::IntVect& dom_lo, const amrex::IntVect& dom_hi,
+        amrex::GpuArray<FieldBoundaryType, 3> const& fbndry_lo,
+        amrex::GpuArray<FieldBoundaryType, 3> const& fbndry_hi,
+        FieldBoundaryType bc_type)
+    {
+        amrex::Vector<amrex::Box> boxes;
+        for (int idim = 0; idim < AMREX_SPACEDIM && tb.ok(); ++idim) {
+            // Points with dom_lo - ijk >= 0: removed from tb once added,
+            // so that the boxes do not overlap in the corners
+            const int lo_edge = dom_lo[idim];
+            if (fbndry_lo[idim] == bc_type && tb.smallEnd(idim) <= lo_edge) {
+                amrex::Box b = tb;
+                b.setBig(idim, std::min(tb.bigEnd(idim), lo_edge));
+                boxes.push_back(b);
+                tb.setSmall(idim, lo_edge + 1);
+            }
+            // Points with ijk - (dom_hi + is_nodal) >= 0
+            const int hi_edge = dom_hi[idim] + is_nodal[idim];
+            if (fbndry_hi[idim] == bc_type && tb.ok() && tb.bigEnd(idim) >= hi_edge) {
+                amrex::Box b = tb;
+                b.setSmall(idim, std::max(tb.smallEnd(idim), hi_edge));
+                boxes.push_back(b);
+                tb.setBig(idim, hi_edge - 1);
+            }
+        }
+        return boxes;
+    }
+
 
     /**
      * \brief Sets the electric field value tangential to the PEC boundary to zero. The
@@ -622,6 +670,84 @@ PEC::ApplyPECtoBfield (
 }
 
 
+void
+PEC::ApplyPECtoEfieldOnTile (
+    amrex::MFIter const& mfi,
+    std::array<amrex::MultiFab*, 3> const& Efield,
+    const amrex::Array<FieldBoundaryType,AMREX_SPACEDIM>& field_boundary_lo,
+    const amrex::Array<FieldBoundaryType,AMREX_SPACEDIM>& field_boundary_hi,
+    FieldBoundaryType bc_type,
+    const amrex::IntVect& ng_fieldgather, const amrex::Box& domain_box)
+{
+    const amrex::IntVect domain_lo = domain_box.smallEnd();
+    const amrex::IntVect domain_hi = domain_box.bigEnd();
+    amrex::GpuArray<FieldBoundaryType, 3> fbndry_lo;
+    amrex::GpuArray<FieldBoundaryType, 3> fbndry_hi;
+    for (int idim=0; idim < AMREX_SPACEDIM; ++idim) {
+        fbndry_lo[idim] = field_boundary_lo[idim];
+        fbndry_hi[idim] = field_boundary_hi[idim];
+    }
+
+    for (int icomp = 0; icomp < 3; ++icomp) {
+        amrex::Array4<amrex::Real> const& E = Efield[icomp]->array(mfi);
+        const amrex::IntVect E_nodal = Efield[icomp]->ixType().toIntVect();
+        const int nComp = Efield[icomp]->nComp();
+
+        // Same cells as in ApplyPECtoEfield, restricted to the boundaries
+        const amrex::Box tb = mfi.tilebox(E_nodal, ng_fieldgather);
+        for (amrex::Box const& b : ::get_boxes_on_boundary(
+                 tb, E_nodal, domain_lo, domain_hi, fbndry_lo, fbndry_hi, bc_type)) {
+            amrex::ParallelFor(b, nComp,
+                [=] AMREX_GPU_DEVICE (int i, int j, int k, int n) {
+                    amrex::ignore_unused(j,k);
+                    const amrex::IntVect iv(AMREX_D_DECL(i,j,k));
+                    ::SetEfieldOnPEC(icomp, domain_lo, domain_hi, iv, n,
+                                     E, E_nodal, fbndry_lo, fbndry_hi, bc_type);
+                });
+        }
+    }
+}
+
+
+void
+PEC::ApplyPECtoBfieldOnTile (
+    amrex::MFIter const& mfi,
+    std::array<amrex::MultiFab*, 3> const& Bfield,
+    const amrex::Array<FieldBoundaryType,AMREX_SPACEDIM>& field_boundary_lo,
+    const amrex::Array<FieldBoundaryType,AMREX_SPACEDIM>& field_boundary_hi,
+    FieldBoundaryType bc_type,
+    const amrex::IntVect& ng_fieldgather, const amrex::Box& domain_box)
+{
+    const amrex::IntVect domain_lo = domain_box.smallEnd();
+    const amrex::IntVect domain_hi = domain_box.bigEnd();
+    amrex::GpuArray<FieldBoundaryType, 3> fbndry_lo;
+    amrex::GpuArray<FieldBoundaryType, 3> fbndry_hi;
+    for (int idim=0; idim < AMREX_SPACEDIM; ++idim) {
+        fbndry_lo[idim] = field_boundary_lo[idim];
+        fbndry_hi[idim] = field_boundary_hi[idim];
+    }
+
+    for (int icomp = 0; icomp < 3; ++icomp) {
+        amrex::Array4<amrex::Real> const& B = Bfield[icomp]->array(mfi);
+        const amrex::IntVect B_nodal = Bfield[icomp]->ixType().toIntVect();
+        const int nComp = Bfield[icomp]->nComp();
+
+        // Same cells as in ApplyPECtoBfield, restricted to the boundaries
+        const amrex::Box tb = mfi.tilebox(B_nodal, ng_fieldgather);
+        for (amrex::Box const& b : ::get_boxes_on_boundary(
+                 tb, B_nodal, domain_lo, domain_hi, fbndry_lo, fbndry_hi, bc_type)) {
+            amrex::ParallelFor(b, nComp,
+                [=] AMREX_GPU_DEVICE (int i, int j, int k, int n) {
+                    amrex::ignore_unused(j,k);
+                    const amrex::IntVect iv(AMREX_D_DECL(i,j,k));
+                    ::SetBfieldOnPEC(icomp, domain_lo, domain_hi, iv, n,
+                                     B, B_nodal, fbndry_lo, fbndry_hi, bc_type);
+                });
+        }
+    }
+}
+
+
 /**
  * \brief Sets the rho field value in cells close to and inside a PEC boundary.
  *        The charge density deposited in the guard cells are either reflected
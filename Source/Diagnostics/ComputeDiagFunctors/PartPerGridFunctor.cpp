@@ -2,12 +2,15 @@
 
 #include "Diagnostics/ComputeDiagFunctors/ComputeDiagFunctor.H"
 #include "Particles/MultiParticleContainer.H"
+#include "Particles/WarpXParticleContainer.H"
 #include "WarpX.H"
 
 #include <ablastr/coarsen/sample.H>
 
 #include <AMReX_BLassert.H>
+#include <AMReX_BoxArray.H>
 #include <AMReX_Config.H>
+#include <AMReX_DistributionMapping.H>
 #include <AMReX_FArrayBox.H>
 #include <AMReX_FabArray.H>
 #include <AMReX_GpuControl.H>
@@ -40,7 +43,15 @@ PartPerGridFunctor::operator()(amrex::MultiFab& mf_dst, const int dcomp, const i
     constexpr int ng = 1;
     // Temporary MultiFab containing number of particles per grid.
     // (stored as constant for all cells in each grid)
-    amrex::MultiFab ppg_mf(warpx.boxArray(m_lev), warpx.DistributionMap(m_lev), 1, ng);
+    // The grids are those of the particles, which differ from those of the fields
+    // with algo.decouple_particle_layout.
+    auto const& mypc = warpx.GetPartContainer();
+    const bool has_particles = mypc.nContainers() > 0;
+    amrex::BoxArray const& pba = has_particles ?
+        mypc.GetParticleContainer(0).ParticleBoxArray(m_lev) : warpx.boxArray(m_lev);
+    amrex::DistributionMapping const& pdm = has_particles ?
+        mypc.GetParticleContainer(0).ParticleDistributionMap(m_lev) : warpx.DistributionMap(m_lev);
+    amrex::MultiFab ppg_mf(pba, pdm, 1, ng);
 #ifdef AMREX_USE_OMP
 #pragma omp parallel
 #endif
@@ -49,5 +60,13 @@ PartPerGridFunctor::operator()(amrex::MultiFab& mf_dst, const int dcomp, const i
     }
 
     // Coarsen and interpolate from ppg_mf to the output diagnostic MultiFab, mf_dst.
-    ablastr::coarsen::sample::Coarsen(mf_dst, ppg_mf, dcomp, 0, nComp(), 0, m_crse_ratio);
+    if (pba == warpx.boxArray(m_lev) && pdm == warpx.DistributionMap(m_lev)) {
+        ablastr::coarsen::sample::Coarsen(mf_dst, ppg_mf, dcomp, 0, nComp(), 0, m_crse_ratio);
+    } else {
+        // Copy the number of particles to the grids of the fields first
+        amrex::MultiFab ppg_field_mf(warpx.boxArray(m_lev), warpx.DistributionMap(m_lev), 1, ng);
+        ppg_field_mf.setVal(0.0);
+        ppg_field_mf.ParallelCopy(ppg_mf, 0, 0, 1);
+        ablastr::coarsen::sample::Coarsen(mf_dst, ppg_field_mf, dcomp, 0, nComp(), 0, m_crse_ratio);
+    }
 }
@@ -11,6 +11,8 @@
 
 #include <AMReX_Array.H>
 #include <AMReX_BLassert.H>
+#include <AMReX_BoxArray.H>
+#include <AMReX_DistributionMapping.H>
 #include <AMReX_IntVect.H>
 #include <AMReX_MultiFab.H>
 #include <AMReX_REAL.H>
@@ -34,10 +36,15 @@ TemperatureFunctor::operator() (amrex::MultiFab& mf_dst, const int dcomp, const
     // the operations performend in the CoarsenAndInterpolate function.
     constexpr int ng = 1;
 
-    // Temporary cell-centered, multi-component MultiFab for storing particles sums and result
-    amrex::MultiFab sum_mf(warpx.boxArray(m_lev), warpx.DistributionMap(m_lev), 7, ng);
-
     auto& pc = warpx.GetPartContainer().GetParticleContainer(m_ispec);
+
+    // Temporary cell-centered, multi-component MultiFab for storing particles sums and result.
+    // It is defined on the boxes of the particles, which differ from those of the fields
+    // with algo.decouple_particle_layout.
+    amrex::BoxArray const& pba = pc.ParticleBoxArray(m_lev);
+    amrex::DistributionMapping const& pdm = pc.ParticleDistributionMap(m_lev);
+    amrex::MultiFab sum_mf(pba, pdm, 7, ng);
+
     amrex::Real const mass = pc.getMass();  // Note, implicit conversion from ParticleReal
 
     WARPX_ALWAYS_ASSERT_WITH_MESSAGE(mass > 0.,
@@ -131,6 +138,14 @@ TemperatureFunctor::operator() (amrex::MultiFab& mf_dst, const int dcomp, const
     }
 
     // Coarsen and interpolate from sum_mf to the output diagnostic MultiFab, mf_dst.
-    ablastr::coarsen::sample::Coarsen(mf_dst, sum_mf, dcomp, 0, nComp(), 0, m_crse_ratio);
+    if (pba == warpx.boxArray(m_lev) && pdm == warpx.DistributionMap(m_lev)) {
+        ablastr::coarsen::sample::Coarsen(mf_dst, sum_mf, dcomp, 0, nComp(), 0, m_crse_ratio);
+    } else {
+        // Copy the temperature to the boxes of the fields first
+        amrex::MultiFab temperature_mf(warpx.boxArray(m_lev), warpx.DistributionMap(m_lev), 1, ng);
+        temperature_mf.setVal(0._rt);
+        temperature_mf.ParallelCopy(sum_mf, 0, 0, 1);
+        ablastr::coarsen::sample::Coarsen(mf_dst, temperature_mf, dcomp, 0, nComp(), 0, m_crse_ratio);
+    }
 
 }
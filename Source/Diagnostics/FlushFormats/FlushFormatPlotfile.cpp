@@ -7,6 +7,7 @@
 #include "Particles/WarpXParticleContainer.H"
 #include "Particles/ParticleIO.H"
 #include "Particles/PinnedMemoryParticleContainer.H"
+#include "Particles/Sorting/CellIndex.H"
 #include "Utils/Interpolate.H"
 #include "Utils/Parser/ParserUtils.H"
 #include "Utils/TextMsg.H"
@@ -395,8 +396,11 @@ FlushFormatPlotfile::WriteParticles(const std::string& dir,
             int_names[index] = inames[index];
         }
 
-        // plot by default
+        // plot by default, except the cached cell index
         int_flags.resize(tmp.NumIntComps(), 1);
+        for (std::size_t index = 0; index < inames.size(); ++index) {
+            if (IsCellIndexCompName(inames[index])) { int_flags[index] = 0; }
+        }
 
         const auto mass = pc->AmIA<PhysicalSpecies::photon>() ? PhysConst::m_e : pc->getMass();
         RandomFilter const random_filter(part_diag.m_do_random_filter,
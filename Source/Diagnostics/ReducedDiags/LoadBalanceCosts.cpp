@@ -127,10 +127,18 @@ void LoadBalanceCosts::ComputeDiags (int step)
 
     using ablastr::fields::Direction;
 
+    // the per-kernel costs are the last fields of each box
+    constexpr int nKernels = static_cast<int>(KernelCost::NumKernels);
+    constexpr int kernelField = m_nDataFields - nKernels;
+
     // save data
     for (int lev = 0; lev < nLevels; ++lev)
     {
         const amrex::DistributionMapping& dm = warpx.DistributionMap(lev);
+        // only filled with timers; left at 0 for the heuristic update
+        const amrex::LayoutData<KernelCosts>* kernel_costs =
+            (WarpX::load_balance_costs_update_algo == LoadBalanceCostsUpdateAlgo::Timers)
+            ? WarpX::getKernelCosts(lev) : nullptr;
         const MultiFab & Ex = *warpx.m_fields.get(FieldType::Efield_aux, Direction{0}, lev);
         for (MFIter mfi(Ex, false); mfi.isValid(); ++mfi)
         {
@@ -154,6 +162,12 @@ void LoadBalanceCosts::ComputeDiags (int step)
 #ifdef AMREX_USE_GPU
             m_data[shift_m_data + mfi.index()*m_nDataFields + 8] = amrex::Gpu::Device::deviceId();
 #endif
+            if (kernel_costs) {
+                for (int k = 0; k < nKernels; ++k) {
+                    m_data[shift_m_data + mfi.index()*m_nDataFields + kernelField + k] =
+                        (*kernel_costs)[mfi.index()][k];
+                }
+            }
             // ...
         }
 
@@ -227,13 +241,13 @@ void LoadBalanceCosts::ComputeDiags (int step)
     }
 
     /* m_data now contains up-to-date values for:
-     *  [[cost, proc, lev, i_low, j_low, k_low, num_cells, num_macro_particles(, gpu_ID [if GPU run]) ] of box 0 at level 0,
-     *   [cost, proc, lev, i_low, j_low, k_low, num_cells, num_macro_particles(, gpu_ID [if GPU run]) ] of box 1 at level 0,
-     *   [cost, proc, lev, i_low, j_low, k_low, num_cells, num_macro_particles(, gpu_ID [if GPU run]) ] of box 2 at level 0,
+     *  [[cost, proc, lev, i_low, j_low, k_low, num_cells, num_macro_particles(, gpu_ID [if GPU run]), cost_gather_push, cost_deposition, cost_field_solve, cost_collisions, cost_particle_creation ] of box 0 at level 0,
+     *   [cost, proc, lev, i_low, j_low, k_low, num_cells, num_macro_particles(, gpu_ID [if GPU run]), cost_gather_push, cost_deposition, cost_field_solve, cost_collisions, cost_particle_creation ] of box 1 at level 0,
+     *   [cost, proc, lev, i_low, j_low, k_low, num_cells, num_macro_particles(, gpu_ID [if GPU run]), cost_gather_push, cost_deposition, cost_field_solve, cost_collisions, cost_particle_creation ] of box 2 at level 0,
      *   ...
-     *   [cost, proc, lev, i_low, j_low, k_low num_cells, num_macro_particles(, gpu_ID [if GPU run]) ] of box 0 at level 1,
-     *   [cost, proc, lev, i_low, j_low, k_low, num_cells, num_macro_particles(, gpu_ID [if GPU run]) ] of box 1 at level 1,
-     *   [cost, proc, lev, i_low, j_low, k_low, num_cells, num_macro_particles(, gpu_ID [if GPU run]) ] of box 2 at level 1,
+     *   [cost, proc, lev, i_low, j_low, k_low num_cells, num_macro_particles(, gpu_ID [if GPU run]), cost_gather_push, cost_deposition, cost_field_solve, cost_collisions, cost_particle_creation ] of box 0 at level 1,
+     *   [cost, proc, lev, i_low, j_low, k_low, num_cells, num_macro_particles(, gpu_ID [if GPU run]), cost_gather_push, cost_deposition, cost_field_solve, cost_collisions, cost_particle_creation ] of box 1 at level 1,
+     *   [cost, proc, lev, i_low, j_low, k_low, num_cells, num_macro_particles(, gpu_ID [if GPU run]), cost_gather_push, cost_deposition, cost_field_solve, cost_collisions, cost_particle_creation ] of box 2 at level 1,
      *   ...]
      * and m_data_string contains:
      *  [hostname of box 0 at level 0,
@@ -297,8 +311,10 @@ void LoadBalanceCosts::WriteToFile (int step) const
         std::ofstream ofstmp(fileTmpName, std::ofstream::out);
 
         // write header row
-        // for each box on each level we saved 9(10) data fields:
-        //   [cost, proc, lev, i_low, j_low, k_low, num_cells, num_macro_particles(, gpu_ID_box), hostname]
+        // for each box on each level we saved 14(15) data fields:
+        //   [cost, proc, lev, i_low, j_low, k_low, num_cells, num_macro_particles(, gpu_ID_box),
+        //    cost_gather_push, cost_deposition, cost_field_solve, cost_collisions,
+        //    cost_particle_creation, hostname]
         // nDataFieldsToWrite = below accounts for the Real data fields (m_nDataFields), then 1 string output to write
         const int nDataFieldsToWrite = m_nDataFields + 1;
 
@@ -330,6 +346,16 @@ void LoadBalanceCosts::WriteToFile (int step) const
             ofstmp << m_sep;
             ofstmp << "[" << c++ << "]gpu_ID_box_" + std::to_string(boxNumber) + "()";
 #endif
+            ofstmp << m_sep;
+            ofstmp << "[" << c++ << "]cost_gather_push_box_" + std::to_string(boxNumber) + "()";
+            ofstmp << m_sep;
+            ofstmp << "[" << c++ << "]cost_deposition_box_" + std::to_string(boxNumber) + "()";
+            ofstmp << m_sep;
+            ofstmp << "[" << c++ << "]cost_field_solve_box_" + std::to_string(boxNumber) + "()";
+            ofstmp << m_sep;
+            ofstmp << "[" << c++ << "]cost_collisions_box_" + std::to_string(boxNumber) + "()";
+            ofstmp << m_sep;
+            ofstmp << "[" << c++ << "]cost_particle_creation_box_" + std::to_string(boxNumber) + "()";
             ofstmp << m_sep;
             ofstmp << "[" << c++ << "]hostname_box_" + std::to_string(boxNumber) + "()";
         }
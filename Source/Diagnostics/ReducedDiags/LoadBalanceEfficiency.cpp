@@ -29,8 +29,9 @@ LoadBalanceEfficiency::LoadBalanceEfficiency (const std::string& rd_name)
     pp_amr.query("max_level", nLevel);
     nLevel += 1;
 
-    // resize data array
-    m_data.resize(nLevel, 0.0_rt);
+    // resize data array: efficiency of the current distribution mapping (predicted at the
+    // last load balance), then efficiency achieved by the previous one, for each level
+    m_data.resize(2*nLevel, 0.0_rt);
 
     if (ParallelDescriptor::IOProcessor())
     {
@@ -50,6 +51,11 @@ LoadBalanceEfficiency::LoadBalanceEfficiency (const std::string& rd_name)
                 ofs << m_sep;
                 ofs << "[" << c++ << "]lev" + std::to_string(lev);
             }
+            for (int lev = 0; lev < nLevel; ++lev)
+            {
+                ofs << m_sep;
+                ofs << "[" << c++ << "]lev" + std::to_string(lev) + "_achieved";
+            }
             ofs << "\n";
 
             // close file
@@ -69,18 +75,22 @@ void LoadBalanceEfficiency::ComputeDiags (int step)
 
     // get number of level
     const auto nLevel = warpx.finestLevel() + 1;
+    const auto nLevelMax = static_cast<int>(m_data.size())/2;
 
     // loop over refinement levels
     for (int lev = 0; lev < nLevel; ++lev)
     {
         // save data
         m_data[lev] = warpx.getLoadBalanceEfficiency(lev);
+        m_data[nLevelMax + lev] = warpx.getLoadBalanceEfficiencyAchieved(lev);
     }
     // end loop over refinement levels
 
     /* m_data now contains up-to-date values for:
      *  [load balance efficiency at level 0,
      *   load balance efficiency at level 1,
-     *   load balance efficiency at level 2,
+     *   ......,
+     *   achieved load balance efficiency at level 0,
+     *   achieved load balance efficiency at level 1,
      *   ......] */
 }
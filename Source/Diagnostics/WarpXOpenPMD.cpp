@@ -10,6 +10,7 @@
 #include "Diagnostics/ParticleDiag/ParticleDiag.H"
 #include "FieldIO.H"
 #include "Particles/Filter/FilterFunctors.H"
+#include "Particles/Sorting/CellIndex.H"
 #include "Utils/TextMsg.H"
 #include "Utils/Parser/ParserUtils.H"
 #include "Utils/RelativeCellPosition.H"
@@ -634,9 +635,13 @@ for (const auto & particle_diag : particle_diags) {
         int_names[i] = detail::snakeToCamel(in[i]);
     }
 
-    // plot by default
+    // plot by default, except the cached cell index
     amrex::Vector<int> int_flags;
     int_flags.resize(tmp.NumIntComps(), 1);
+    for (size_t i = 0; i < in.size(); ++i)
+    {
+        if (IsCellIndexCompName(in[i])) { int_flags[i] = 0; }
+    }
 
     // real_names contains a list of all real particle attributes.
     // real_flags is 1 or 0, whether quantity is dumped or not.
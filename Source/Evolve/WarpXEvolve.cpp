@@ -36,7 +36,9 @@
 #include "Utils/WarpXConst.H"
 #include "Utils/WarpXProfilerWrapper.H"
 
+#include <ablastr/utils/Communication.H>
 #include <ablastr/utils/SignalHandling.H>
+#include <ablastr/utils/TaskGraph.H>
 #include <ablastr/warn_manager/WarnManager.H>
 
 #include <AMReX.H>
@@ -54,8 +56,10 @@
 
 #include <algorithm>
 #include <array>
+#include <cstdlib>
 #include <memory>
 #include <ostream>
+#include <string>
 #include <vector>
 
 using namespace amrex;
@@ -93,15 +97,16 @@ WarpX::Synchronize () {
     UpdateAuxilaryData();
     FillBoundaryAux(guard_cells.ng_UpdateAux);
     for (int lev = 0; lev <= finest_level; ++lev) {
+        auto& particle_fields = GetParticleFields(lev);
         mypc->PushP(
             lev,
             0.5_rt*dt[lev],
-            *m_fields.get(FieldType::Efield_aux, Direction{0}, lev),
-            *m_fields.get(FieldType::Efield_aux, Direction{1}, lev),
-            *m_fields.get(FieldType::Efield_aux, Direction{2}, lev),
-            *m_fields.get(FieldType::Bfield_aux, Direction{0}, lev),
-            *m_fields.get(FieldType::Bfield_aux, Direction{1}, lev),
-            *m_fields.get(FieldType::Bfield_aux, Direction{2}, lev)
+            *particle_fields.get(FieldType::Efield_aux, Direction{0}, lev),
+            *particle_fields.get(FieldType::Efield_aux, Direction{1}, lev),
+            *particle_fields.get(FieldType::Efield_aux, Direction{2}, lev),
+            *particle_fields.get(FieldType::Bfield_aux, Direction{0}, lev),
+            *particle_fields.get(FieldType::Bfield_aux, Direction{1}, lev),
+            *particle_fields.get(FieldType::Bfield_aux, Direction{2}, lev)
         );
     }
     is_synchronized = true;
@@ -262,6 +267,13 @@ WarpX::Evolve (int numsteps)
         // We might need to move j because we are going to make a plotfile.
         const int num_moved = MoveWindow(step+1, move_j);
 
+        // The shift of E and B by num_moved cells pulls outdated guard cells
+        // into the guard cells at the upper (or lower) end of the boxes
+        if (num_moved != 0 && m_fdtd_deep_halo_steps > 1) {
+            m_ng_valid_E[moving_window_dir] = std::max(m_ng_valid_E[moving_window_dir] - std::abs(num_moved), 0);
+            m_ng_valid_B[moving_window_dir] = std::max(m_ng_valid_B[moving_window_dir] - std::abs(num_moved), 0);
+        }
+
         // Update the accelerator lattice element finder if the window has moved,
         // from either a moving window or a boosted frame
         if (num_moved != 0 || gamma_boost > 1) {
@@ -380,14 +392,20 @@ WarpX::OneStep_nosub (Real cur_time)
     ExecutePythonCallback("particlescraper");
     ExecutePythonCallback("beforedeposition");
 
-    PushParticlesandDeposit(cur_time);
+    // With the task graph, the current is also filtered and summed
+    const bool use_task_graph = CanUseTaskGraph();
+    if (use_task_graph) {
+        PushParticlesandDepositTaskGraph(cur_time);
+    } else {
+        PushParticlesandDeposit(cur_time);
+    }
 
     ExecutePythonCallback("afterdeposition");
 
     // Synchronize J and rho:
     // filter (if used), exchange guard cells, interpolate across MR levels
     // and apply boundary conditions
-    SyncCurrentAndRho();
+    SyncCurrentAndRho(use_task_graph);
 
     // At this point, J is up-to-date inside the domain, and E and B are
     // up-to-date including enough guard cells for first step of the field
@@ -435,23 +453,36 @@ WarpX::OneStep_nosub (Real cur_time)
         FillBoundaryF(guard_cells.ng_FieldSolverF);
         FillBoundaryG(guard_cells.ng_FieldSolverG);
 
-        EvolveB(0.5_rt * dt[0], DtType::FirstHalf, cur_time); // We now have B^{n+1/2}
-        FillBoundaryB(guard_cells.ng_FieldSolver, WarpX::sync_nodal_points);
+        // With the deep halo, the field solve is advanced redundantly in the guard
+        // cells of E and B, which are only exchanged in ExplicitFillBoundaryEBUpdateAux
+        const bool fill_guard_cells = (m_fdtd_deep_halo_steps == 1);
 
-        if (m_em_solver_medium == MediumForEM::Vacuum) {
-            // vacuum medium
-            EvolveE(dt[0], cur_time); // We now have E^{n+1}
-        } else if (m_em_solver_medium == MediumForEM::Macroscopic) {
-            // macroscopic medium
-            MacroscopicEvolveE(dt[0], cur_time); // We now have E^{n+1}
+        if (CanUseTemporalBlocking()) {
+            // We now have B^{n+1/2}, E^{n+1} and B^{n+1}, from a single sweep through the fields
+            EvolveEBTemporalBlocking(dt[0]);
         } else {
-            WARPX_ABORT_WITH_MESSAGE("Medium for EM is unknown");
-        }
-        FillBoundaryE(guard_cells.ng_FieldSolver, WarpX::sync_nodal_points);
+            EvolveB(0.5_rt * dt[0], DtType::FirstHalf, cur_time); // We now have B^{n+1/2}
+            if (fill_guard_cells) {
+                FillBoundaryB(guard_cells.ng_FieldSolver, WarpX::sync_nodal_points);
+            }
 
-        EvolveF(0.5_rt * dt[0], DtType::SecondHalf);
-        EvolveG(0.5_rt * dt[0], DtType::SecondHalf);
-        EvolveB(0.5_rt * dt[0], DtType::SecondHalf, cur_time + 0.5_rt * dt[0]); // We now have B^{n+1}
+            if (m_em_solver_medium == MediumForEM::Vacuum) {
+                // vacuum medium
+                EvolveE(dt[0], cur_time); // We now have E^{n+1}
+            } else if (m_em_solver_medium == MediumForEM::Macroscopic) {
+                // macroscopic medium
+                MacroscopicEvolveE(dt[0], cur_time); // We now have E^{n+1}
+            } else {
+                WARPX_ABORT_WITH_MESSAGE("Medium for EM is unknown");
+            }
+            if (fill_guard_cells) {
+                FillBoundaryE(guard_cells.ng_FieldSolver, WarpX::sync_nodal_points);
+            }
+
+            EvolveF(0.5_rt * dt[0], DtType::SecondHalf);
+            EvolveG(0.5_rt * dt[0], DtType::SecondHalf);
+            EvolveB(0.5_rt * dt[0], DtType::SecondHalf, cur_time + 0.5_rt * dt[0]); // We now have B^{n+1}
+        }
 
         if (do_pml) {
             DampPML();
@@ -494,21 +525,24 @@ void WarpX::ExplicitFillBoundaryEBUpdateAux ()
         // Not called at each iteration, so exchange all guard cells
         FillBoundaryE(guard_cells.ng_alloc_EB);
         FillBoundaryB(guard_cells.ng_alloc_EB);
+        m_ng_valid_E = guard_cells.ng_alloc_EB;
+        m_ng_valid_B = guard_cells.ng_alloc_EB;
 
         UpdateAuxilaryData();
         FillBoundaryAux(guard_cells.ng_UpdateAux);
         // on first step, push p by -0.5*dt
         for (int lev = 0; lev <= finest_level; ++lev)
         {
+            auto& particle_fields = GetParticleFields(lev);
             mypc->PushP(
                 lev,
                 -0.5_rt*dt[lev],
-                *m_fields.get(FieldType::Efield_aux, Direction{0}, lev),
-                *m_fields.get(FieldType::Efield_aux, Direction{1}, lev),
-                *m_fields.get(FieldType::Efield_aux, Direction{2}, lev),
-                *m_fields.get(FieldType::Bfield_aux, Direction{0}, lev),
-                *m_fields.get(FieldType::Bfield_aux, Direction{1}, lev),
-                *m_fields.get(FieldType::Bfield_aux, Direction{2}, lev)
+                *particle_fields.get(FieldType::Efield_aux, Direction{0}, lev),
+                *particle_fields.get(FieldType::Efield_aux, Direction{1}, lev),
+                *particle_fields.get(FieldType::Efield_aux, Direction{2}, lev),
+                *particle_fields.get(FieldType::Bfield_aux, Direction{0}, lev),
+                *particle_fields.get(FieldType::Bfield_aux, Direction{1}, lev),
+                *particle_fields.get(FieldType::Bfield_aux, Direction{2}, lev)
             );
         }
         is_synchronized = false;
@@ -519,6 +553,32 @@ void WarpX::ExplicitFillBoundaryEBUpdateAux ()
         // E and B: enough guard cells to update Aux or call Field Gather in fp and cp
         // Need to update Aux on lower levels, to interpolate to higher levels.
 
+        if (m_fdtd_deep_halo_steps > 1) {
+            // The guard cells of E and B were advanced by the field solve:
+            // exchange them only once they are too shallow for the field gather
+            // followed by another field solve
+            const amrex::IntVect ng_needed = amrex::max(guard_cells.ng_FieldGather, guard_cells.ng_UpdateAux);
+            const amrex::IntVect& ng_solver = guard_cells.ng_FieldSolver;
+            if (!m_ng_valid_E.allGE(amrex::max(ng_needed, 3*ng_solver)) ||
+                !m_ng_valid_B.allGE(amrex::max(ng_needed, 2*ng_solver))) {
+                FillBoundaryE(guard_cells.ng_DeepHalo, WarpX::sync_nodal_points);
+                FillBoundaryB(guard_cells.ng_DeepHalo, WarpX::sync_nodal_points);
+                m_ng_valid_E = guard_cells.ng_DeepHalo;
+                m_ng_valid_B = guard_cells.ng_DeepHalo;
+            }
+            UpdateAuxilaryData();
+            FillBoundaryAux(guard_cells.ng_UpdateAux);
+            return;
+        }
+
+        if (CanOverlapGuardCellExchange()) {
+            // The guard cells of E and B are exchanged by PushParticlesandDeposit,
+            // while the particles that do not gather from them are pushed.
+            // Aux is an alias of fp on the single level: there is nothing to update.
+            m_guard_cell_exchange_deferred = true;
+            return;
+        }
+
         // E and B are up-to-date inside the domain only
         FillBoundaryE(guard_cells.ng_FieldGather);
         FillBoundaryB(guard_cells.ng_FieldGather);
@@ -538,6 +598,211 @@ void WarpX::ExplicitFillBoundaryEBUpdateAux ()
     }
 }
 
+bool WarpX::CanOverlapGuardCellExchange () const
+{
+    if (!m_overlap_guard_cell_exchange) { return false; }
+
+    // Explicit FDTD scheme on a single level, with double precision comms
+    if (finest_level != 0 || evolve_scheme != EvolveScheme::Explicit || do_multi_J ||
+        electrostatic_solver_id != ElectrostaticSolverAlgo::None ||
+        electromagnetic_solver_id == ElectromagneticSolverAlgo::None ||
+        electromagnetic_solver_id == ElectromagneticSolverAlgo::HybridPIC ||
+        electromagnetic_solver_id == ElectromagneticSolverAlgo::PSATD ||
+        WarpX::do_single_precision_comms || WarpX::use_fdtd_nci_corr) {
+        return false;
+    }
+
+    // The particles gather from aux, which must be an alias of fp
+    if ((field_gathering_algo == GatheringAlgo::MomentumConserving && grid_type != GridType::Collocated) ||
+        mypc->m_E_ext_particle_s == "read_from_file" || mypc->m_B_ext_particle_s == "read_from_file") {
+        return false;
+    }
+
+    // No process between the exchange and the push may read the guard cells
+    for (int i = 0; i < mypc->nContainers(); ++i) {
+        auto const& pc = mypc->GetParticleContainer(i);
+        if (pc.DoFieldIonization() || pc.DoQED()) { return false; }
+    }
+    for (const auto* callback : {"beforecollisions", "aftercollisions", "particleinjection",
+                                 "particlescraper", "beforedeposition"}) {
+        if (IsPythonCallbackInstalled(callback)) { return false; }
+    }
+
+    return true;
+}
+
+bool WarpX::CanUseTemporalBlocking () const
+{
+    if (!m_fdtd_temporal_blocking) { return false; }
+
+#ifdef AMREX_USE_GPU
+    // The sweep by slabs of planes serializes the boxes: there is no cache to block for
+    return false;
+#endif
+
+    // The deep halo provides the guard cells that are advanced redundantly between
+    // the sub-steps: it already requires a single level, a vacuum medium and an
+    // explicit scheme without divergence cleaning
+    if (m_fdtd_deep_halo_steps == 1 || grid_type == GridType::Collocated ||
+        (electromagnetic_solver_id != ElectromagneticSolverAlgo::Yee &&
+         electromagnetic_solver_id != ElectromagneticSolverAlgo::CKC)) {
+        return false;
+    }
+
+    // The field boundary conditions are applied after each sub-step
+    const auto is_periodic = [](const FieldBoundaryType fbt) {
+        return fbt == FieldBoundaryType::Periodic;
+    };
+    if (do_pml ||
+        !std::all_of(field_boundary_lo.begin(), field_boundary_lo.end(), is_periodic) ||
+        !std::all_of(field_boundary_hi.begin(), field_boundary_hi.end(), is_periodic)) {
+        return false;
+    }
+
+    // The callbacks would read the fields between the sub-steps
+    if (IsPythonCallbackInstalled("afterBpush") || IsPythonCallbackInstalled("afterEpush")) {
+        return false;
+    }
+
+    return true;
+}
+
+bool WarpX::CanUseTaskGraph () const
+{
+    using ablastr::fields::Direction;
+    using warpx::fields::FieldType;
+
+    if (!m_do_task_graph) { return false; }
+
+    // Explicit FDTD scheme on a single level, with double precision comms, in which
+    // the particles deposit on current_fp, which is only synchronized by SyncCurrent
+    if (finest_level != 0 || evolve_scheme != EvolveScheme::Explicit || do_multi_J ||
+        electrostatic_solver_id != ElectrostaticSolverAlgo::None ||
+        electromagnetic_solver_id == ElectromagneticSolverAlgo::None ||
+        electromagnetic_solver_id == ElectromagneticSolverAlgo::HybridPIC ||
+        electromagnetic_solver_id == ElectromagneticSolverAlgo::PSATD ||
+        WarpX::do_single_precision_comms || do_current_centering || do_fluid_species ||
+        m_decouple_particle_layout || !m_fields.has(FieldType::current_fp_stage, Direction{0}, 0)) {
+        return false;
+    }
+
+    // Nothing to overlap the summation of the current with
+    if (mypc->nContainers() < 2) { return false; }
+
+    // The current would be summed before the callback reads it
+    if (IsPythonCallbackInstalled("afterdeposition")) { return false; }
+
+    return true;
+}
+
+void
+WarpX::PushParticlesandDepositTaskGraph (amrex::Real cur_time)
+{
+    WARPX_PROFILE("WarpX::PushParticlesandDepositTaskGraph()");
+
+    using ablastr::utils::TaskGraph;
+    using warpx::fields::FieldType;
+
+    const int lev = 0;
+    const amrex::Periodicity& period = Geom(lev).periodicity();
+    const std::string current_fp_string = "current_fp";
+    const std::string current_stage_string = "current_fp_stage";
+
+    const auto J_fp = m_fields.get_alldirs(FieldType::current_fp, lev);
+    const auto J_stage = m_fields.get_alldirs(FieldType::current_fp_stage, lev);
+
+    TaskGraph graph;
+
+    const TaskGraph::TaskId zero = graph.addTask("WarpX::TaskGraph::zero", [&] () {
+        for (amrex::MultiFab* J : J_fp) { J->setVal(0.0); }
+        for (amrex::MultiFab* J : J_stage) { J->setVal(0.0); }
+        if (m_fields.has(FieldType::rho_fp, lev)) { m_fields.get(FieldType::rho_fp, lev)->setVal(0.0); }
+    });
+
+    // Guard cells of E and B left to the push by ExplicitFillBoundaryEBUpdateAux:
+    // all the species push their interior particles while they are exchanged
+    const bool split_push = m_guard_cell_exchange_deferred;
+    TaskGraph::TaskId fill_EB = zero;
+    if (split_push) {
+        fill_EB = graph.addCommTask("WarpX::TaskGraph::FillBoundaryEB",
+            [&] () { FillBoundaryEB_nowait(guard_cells.ng_FieldGather); },
+            [&] () { FillBoundaryEB_finish(); });
+        m_guard_cell_exchange_deferred = false;
+    }
+
+    // Filter and sum the current of the species that deposited in `J`
+    auto add_sum_tasks = [&] (const std::string& name, ablastr::fields::VectorField const& J,
+                              FieldType J_type, std::vector<TaskGraph::TaskId> const& deps)
+    {
+        const TaskGraph::TaskId filter = graph.addTask("WarpX::TaskGraph::filter_" + name, [=] () {
+#ifdef WARPX_DIM_RZ
+            ApplyInverseVolumeScalingToCurrentDensity(J[0], J[1], J[2], lev);
+#endif
+            if (use_filter) {
+                ApplyFilterMF(m_fields.get_mr_levels_alldirs(J_type, finest_level), lev);
+            }
+        }, deps);
+        return graph.addCommTask("WarpX::TaskGraph::SumBoundary_" + name,
+            [=] () {
+                for (amrex::MultiFab* mf : J) {
+                    ablastr::utils::communication::SumBoundary_nowait(
+                        *mf, 0, mf->nComp(), SumBoundaryJGuardCells(*mf), mf->nGrowVect(), period);
+                }
+            },
+            [=] () {
+                for (amrex::MultiFab* mf : J) {
+                    ablastr::utils::communication::SumBoundary_finish(*mf);
+                }
+            },
+            {filter});
+    };
+
+    // The tasks are added by priority: the current of the first species is summed
+    // while the other species push
+    std::vector<TaskGraph::TaskId> sums;
+    std::vector<TaskGraph::TaskId> stage_pushes;
+    for (int i = 0; i < mypc->nContainers(); ++i) {
+        const std::string& J_string = (i == 0) ? current_fp_string : current_stage_string;
+        const std::string name = "WarpX::TaskGraph::push_" + std::to_string(i);
+        auto push = [&, i, J_string] (PushRegion push_region) {
+            mypc->GetParticleContainer(i).Evolve(m_fields, lev, J_string, cur_time, dt[lev],
+                DtType::Full, false, PushType::Explicit, push_region);
+        };
+
+        TaskGraph::TaskId pushed = -1;
+        if (split_push) {
+            const TaskGraph::TaskId interior = graph.addTask(name + "_interior",
+                [=] () { push(PushRegion::Interior); }, {zero});
+            pushed = graph.addTask(name + "_boundary",
+                [=] () { push(PushRegion::Boundary); }, {interior, fill_EB});
+        } else {
+            pushed = graph.addTask(name, [=] () { push(PushRegion::All); }, {zero});
+        }
+
+        if (i == 0) {
+            sums.push_back(add_sum_tasks("current_fp", J_fp, FieldType::current_fp, {pushed}));
+        } else {
+            stage_pushes.push_back(pushed);
+        }
+    }
+    sums.push_back(add_sum_tasks("current_fp_stage", J_stage, FieldType::current_fp_stage,
+                                 stage_pushes));
+
+    graph.addTask("WarpX::TaskGraph::accumulate", [&] () {
+        for (int idim = 0; idim < 3; ++idim) {
+            amrex::MultiFab::Add(*J_fp[idim], *J_stage[idim], 0, 0, J_fp[idim]->nComp(),
+                                 J_fp[idim]->nGrowVect());
+        }
+#ifdef WARPX_DIM_RZ
+        if (m_fields.has(FieldType::rho_fp, lev)) {
+            ApplyInverseVolumeScalingToChargeDensity(m_fields.get(FieldType::rho_fp, lev), lev);
+        }
+#endif
+    }, sums);
+
+    graph.execute();
+}
+
 void WarpX::HandleParticlesAtBoundaries (int step, amrex::Real cur_time, int num_moved)
 {
     mypc->ContinuousFluxInjection(cur_time, dt[0]);
@@ -549,7 +814,13 @@ void WarpX::HandleParticlesAtBoundaries (int step, amrex::Real cur_time, int num
     if( electromagnetic_solver_id == ElectromagneticSolverAlgo::None ||
         electromagnetic_solver_id == ElectromagneticSolverAlgo::HybridPIC )
     {
-        mypc->Redistribute();
+        if (max_level == 0 && mypc->DoNeighborRedistribute()) {
+            // Most particles move by less than one cell, the others are
+            // handled by the global redistribution
+            mypc->RedistributeNeighbor(1);
+        } else {
+            mypc->Redistribute();
+        }
     }
     else
     {
@@ -564,7 +835,11 @@ void WarpX::HandleParticlesAtBoundaries (int step, amrex::Real cur_time, int num
                 // Standard algorithm ; particles can move by up to 1 cell
                 num_redistribute_ghost += 1;
             }
-            mypc->RedistributeLocal(num_redistribute_ghost);
+            if (mypc->DoNeighborRedistribute()) {
+                mypc->RedistributeNeighbor(num_redistribute_ghost);
+            } else {
+                mypc->RedistributeLocal(num_redistribute_ghost);
+            }
         }
         else {
             mypc->Redistribute();
@@ -588,7 +863,7 @@ void WarpX::HandleParticlesAtBoundaries (int step, amrex::Real cur_time, int num
     }
 }
 
-void WarpX::SyncCurrentAndRho ()
+void WarpX::SyncCurrentAndRho (bool current_is_synced)
 {
     using ablastr::fields::Direction;
     using warpx::fields::FieldType;
@@ -631,7 +906,9 @@ void WarpX::SyncCurrentAndRho ()
     }
     else // FDTD
     {
-        SyncCurrent("current_fp");
+        if (!current_is_synced) {
+            SyncCurrent("current_fp");
+        }
         SyncRho();
     }
 
@@ -1158,17 +1435,31 @@ WarpX::PushParticlesandDeposit (int lev, amrex::Real cur_time, DtType a_dt_type,
         current_fp_string = "current_fp";
     }
 
-    mypc->Evolve(
-        m_fields,
-        lev,
-        current_fp_string,
-        cur_time,
-        dt[lev],
-        a_dt_type,
-        skip_current,
-        push_type
-    );
+    if (m_guard_cell_exchange_deferred) {
+        // Push the particles that do not gather from the guard cells of E and B
+        // while these guard cells are exchanged, then the other particles
+        FillBoundaryEB_nowait(guard_cells.ng_FieldGather);
+        mypc->Evolve(m_fields, lev, current_fp_string, cur_time, dt[lev], a_dt_type,
+                     skip_current, push_type, PushRegion::Interior);
+        FillBoundaryEB_finish();
+        mypc->Evolve(m_fields, lev, current_fp_string, cur_time, dt[lev], a_dt_type,
+                     skip_current, push_type, PushRegion::Boundary);
+        m_guard_cell_exchange_deferred = false;
+    } else {
+        mypc->Evolve(
+            GetParticleFields(lev),
+            lev,
+            current_fp_string,
+            cur_time,
+            dt[lev],
+            a_dt_type,
+            skip_current,
+            push_type
+        );
+    }
     if (! skip_current) {
+        // With decoupled particle boxes, the particles deposited on their own boxes
+        AddParticleLayoutDeposits(lev, current_fp_string);
 #ifdef WARPX_DIM_RZ
         // This is called after all particles have deposited their current and charge.
         ApplyInverseVolumeScalingToCurrentDensity(
@@ -41,6 +41,11 @@ void ElectrostaticSolver::ReadParameters () {
    utils::parser::queryWithParser(
         pp_warpx, "self_fields_verbosity", self_fields_verbosity);
 
+    pp_warpx.query("self_fields_reuse_solver", self_fields_reuse_solver);
+    if (self_fields_reuse_solver) {
+        m_poisson_solver_cache = std::make_unique<ablastr::fields::PoissonSolverCache>();
+    }
+
     // FFT solver flags
    utils::parser::queryWithParser(
         pp_warpx, "use_2d_slices_fft_solver", is_igf_2d_slices);
@@ -127,7 +132,8 @@ ElectrostaticSolver::computePhi (
     Real absolute_tolerance,
     int const max_iters,
     int const verbosity,
-    bool const is_igf_2d
+    bool const is_igf_2d,
+    ablastr::fields::PoissonSolverCache* solver_cache
 ) const
 {
     using ablastr::fields::Direction;
@@ -216,7 +222,8 @@ ElectrostaticSolver::computePhi (
         post_phi_calculation,
         *m_poisson_boundary_handler,
         warpx.gett_new(0),
-        eb_farray_box_factory
+        eb_farray_box_factory,
+        solver_cache ? solver_cache : m_poisson_solver_cache.get()
     );
 
 }
@@ -59,6 +59,14 @@ void LabFrameExplicitES::ComputeSpaceChargeField (
     // Todo: use simpler finite difference form with beta=0
     const std::array<Real, 3> beta = {0._rt};
 
+#if !defined(WARPX_DIM_1D_Z)
+    // start the MLMG solver from the extrapolation of the last two potentials
+    // (otherwise, it starts from the potential of the last step)
+    if (self_fields_extrapolate_guess && !IsPythonCallbackInstalled("poissonsolver")) {
+        ExtrapolatePhiGuess(phi_fp);
+    }
+#endif
+
     // set the boundary potentials appropriately
     setPhiBC(phi_fp, warpx.gett_new(0));
 
@@ -90,6 +98,40 @@ void LabFrameExplicitES::ComputeSpaceChargeField (
     }
 }
 
+void LabFrameExplicitES::ExtrapolatePhiGuess (
+    const ablastr::fields::MultiLevelScalarField& phi)
+{
+    WARPX_PROFILE("LabFrameExplicitES::ExtrapolatePhiGuess");
+
+    m_phi_previous.resize(num_levels);
+    for (int lev = 0; lev < num_levels; lev++) {
+        auto& phi_previous = m_phi_previous[lev];
+
+        // After a regrid, restart from the potential of the last step only
+        if (!phi_previous ||
+            phi_previous->boxArray() != phi[lev]->boxArray() ||
+            phi_previous->DistributionMap() != phi[lev]->DistributionMap() ||
+            phi_previous->nGrowVect() != phi[lev]->nGrowVect())
+        {
+            phi_previous = std::make_unique<MultiFab>(phi[lev]->boxArray(),
+                phi[lev]->DistributionMap(), phi[lev]->nComp(), phi[lev]->nGrowVect());
+            MultiFab::Copy(*phi_previous, *phi[lev], 0, 0, phi[lev]->nComp(), phi[lev]->nGrowVect());
+            continue;
+        }
+
+        // phi^(n+1) ~ 2 phi^n - phi^(n-1), and keep phi^n for the next step
+        auto const& phi_arrs = phi[lev]->arrays();
+        auto const& phi_previous_arrs = phi_previous->arrays();
+        amrex::ParallelFor(*phi[lev], phi[lev]->nGrowVect(), phi[lev]->nComp(),
+            [=] AMREX_GPU_DEVICE (int box_no, int i, int j, int k, int n) noexcept
+            {
+                Real const phi_n = phi_arrs[box_no](i,j,k,n);
+                phi_arrs[box_no](i,j,k,n) = 2._rt*phi_n - phi_previous_arrs[box_no](i,j,k,n);
+                phi_previous_arrs[box_no](i,j,k,n) = phi_n;
+            });
+    }
+}
+
 /* \brief Compute the potential by solving Poisson's equation with
           a 1D tridiagonal solve.
 
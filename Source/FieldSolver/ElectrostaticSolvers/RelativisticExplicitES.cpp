@@ -13,9 +13,16 @@
 #include "Particles/WarpXParticleContainer.H"
 #include "WarpX.H"
 
+#include <ablastr/fields/PoissonSolver.H>
+
+#include <algorithm>
+#include <cmath>
+
 
 using namespace amrex;
 
+RelativisticExplicitES::~RelativisticExplicitES () = default;
+
 void RelativisticExplicitES::InitData () {
     auto & warpx = WarpX::GetInstance();
     bool prepare_field_solve = (WarpX::electrostatic_solver_id == ElectrostaticSolverAlgo::Relativistic);
@@ -46,15 +53,72 @@ void RelativisticExplicitES::ComputeSpaceChargeField (
     MultiLevelVectorField Efield_fp = fields.get_mr_levels_alldirs(FieldType::Efield_fp, max_level);
     MultiLevelVectorField Bfield_fp = fields.get_mr_levels_alldirs(FieldType::Bfield_fp, max_level);
 
-    // Loop over the species and add their space-charge contribution to E and B.
-    // Note that the fields calculated here does not include the E field
-    // due to simulation boundary potentials
+    // Group the species that move at the same velocity (within self_fields_beta_tolerance)
+    // and use the same solver parameters: the space-charge field of each group is
+    // obtained from a single deposition and a single Poisson solve, since the
+    // equation solved is linear in rho and only depends on beta
+    struct SpeciesGroup {
+        Vector<WarpXParticleContainer*> species;
+        std::array<Real, 3> beta_first;  // velocity of the first species, to compare with
+        std::array<Real, 3> beta_sum = {0._rt, 0._rt, 0._rt};
+    };
+    Vector<SpeciesGroup> groups;
     for (auto const& species : mpc) {
-        if (always_run_solve || (species->initialize_self_fields)) {
-            AddSpaceChargeField(*species, Efield_fp, Bfield_fp);
+        if (!(always_run_solve || (species->initialize_self_fields))) { continue; }
+        if (species->getCharge() == 0) { continue; }
+
+        // Get the particle beta vector
+        bool const local_average = false; // Average across all MPI ranks
+        std::array<ParticleReal, 3> const beta_pr = species->meanParticleVelocity(local_average);
+        std::array<Real, 3> beta;
+        for (int i=0 ; i < static_cast<int>(beta.size()) ; i++) {
+            beta[i] = beta_pr[i]/PhysConst::c; // Normalize
+        }
+
+        auto group = std::find_if(groups.begin(), groups.end(), [&](SpeciesGroup const& g) {
+            WarpXParticleContainer const& first = *g.species[0];
+            bool same_beta = true;
+            for (int i=0 ; i < static_cast<int>(beta.size()) ; i++) {
+                same_beta &= std::abs(beta[i] - g.beta_first[i]) <= self_fields_beta_tolerance;
+            }
+            return same_beta &&
+                first.self_fields_required_precision == species->self_fields_required_precision &&
+                first.self_fields_absolute_tolerance == species->self_fields_absolute_tolerance &&
+                first.self_fields_max_iters == species->self_fields_max_iters &&
+                first.self_fields_verbosity == species->self_fields_verbosity;
+        });
+        if (group == groups.end()) {
+            groups.push_back(SpeciesGroup{{}, beta});
+            group = groups.end() - 1;
+        }
+        group->species.push_back(species.get());
+        for (int i=0 ; i < static_cast<int>(beta.size()) ; i++) {
+            group->beta_sum[i] += beta[i];
+        }
+    }
+
+    // Keep the MLMG solvers of each group between the steps, since beta differs between groups
+    if (self_fields_reuse_solver && m_group_solver_caches.size() < groups.size()) {
+        auto const first_new = static_cast<int>(m_group_solver_caches.size());
+        m_group_solver_caches.resize(groups.size());
+        for (int ig = first_new; ig < static_cast<int>(groups.size()); ++ig) {
+            m_group_solver_caches[ig] = std::make_unique<ablastr::fields::PoissonSolverCache>();
         }
     }
 
+    // Loop over the groups and add their space-charge contribution to E and B.
+    // Note that the fields calculated here does not include the E field
+    // due to simulation boundary potentials
+    for (int ig = 0; ig < static_cast<int>(groups.size()); ++ig) {
+        auto const& group = groups[ig];
+        auto const nspecies = static_cast<Real>(group.species.size());
+        std::array<Real, 3> const beta = {group.beta_sum[0]/nspecies,
+                                          group.beta_sum[1]/nspecies,
+                                          group.beta_sum[2]/nspecies};
+        AddSpaceChargeField(group.species, beta, Efield_fp, Bfield_fp,
+                            self_fields_reuse_solver ? m_group_solver_caches[ig].get() : nullptr);
+    }
+
     // Add the field due to the boundary potentials
     if (always_run_solve || (m_poisson_boundary_handler->m_boundary_potential_specified))
     {
@@ -63,13 +127,15 @@ void RelativisticExplicitES::ComputeSpaceChargeField (
 }
 
 void RelativisticExplicitES::AddSpaceChargeField (
-    WarpXParticleContainer& pc,
+    amrex::Vector<WarpXParticleContainer*> const& species,
+    std::array<amrex::Real, 3> beta,
     ablastr::fields::MultiLevelVectorField& Efield_fp,
-    ablastr::fields::MultiLevelVectorField& Bfield_fp)
+    ablastr::fields::MultiLevelVectorField& Bfield_fp,
+    ablastr::fields::PoissonSolverCache* solver_cache)
 {
     WARPX_PROFILE("RelativisticExplicitES::AddSpaceChargeField");
 
-    if (pc.getCharge() == 0) { return; }
+    if (species.empty()) { return; }
 
 #ifdef WARPX_DIM_RZ
     WARPX_ALWAYS_ASSERT_WITH_MESSAGE(WarpX::n_rz_azimuthal_modes == 1,
@@ -105,10 +171,12 @@ void RelativisticExplicitES::AddSpaceChargeField (
     bool const reset = false;
     bool const apply_boundary_and_scale_volume = true;
     bool const interpolate_across_levels = false;
-    if ( !pc.do_not_deposit) {
-        pc.DepositCharge(amrex::GetVecOfPtrs(rho),
-            local, reset, apply_boundary_and_scale_volume,
-            interpolate_across_levels);
+    for (auto* pc : species) {
+        if ( !pc->do_not_deposit) {
+            pc->DepositCharge(amrex::GetVecOfPtrs(rho),
+                local, reset, apply_boundary_and_scale_volume,
+                interpolate_across_levels);
+        }
     }
 
     // Apply filter, perform MPI exchange, interpolate across levels
@@ -118,19 +186,12 @@ void RelativisticExplicitES::AddSpaceChargeField (
         amrex::GetVecOfPtrs(rho_coarse),
         amrex::GetVecOfPtrs(rho_buf));
 
-    // Get the particle beta vector
-    bool const local_average = false; // Average across all MPI ranks
-    std::array<ParticleReal, 3> beta_pr = pc.meanParticleVelocity(local_average);
-    std::array<Real, 3> beta;
-    for (int i=0 ; i < static_cast<int>(beta.size()) ; i++) {
-        beta[i] = beta_pr[i]/PhysConst::c; // Normalize
-    }
-
     // Compute the potential phi, by solving the Poisson equation
+    WarpXParticleContainer const& pc = *species[0];
     computePhi( amrex::GetVecOfPtrs(rho), amrex::GetVecOfPtrs(phi),
                 beta, pc.self_fields_required_precision,
                 pc.self_fields_absolute_tolerance, pc.self_fields_max_iters,
-                pc.self_fields_verbosity, is_igf_2d_slices);
+                pc.self_fields_verbosity, is_igf_2d_slices, solver_cache);
 
     // Compute the corresponding electric and magnetic field, from the potential phi
     computeE( Efield_fp, amrex::GetVecOfPtrs(phi), beta );
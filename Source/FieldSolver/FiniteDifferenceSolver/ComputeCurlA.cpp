@@ -16,6 +16,7 @@
 #   include "FiniteDifferenceAlgorithms/CartesianYeeAlgorithm.H"
 #endif
 
+#include "Parallelization/CostTimer.H"
 #include "Utils/TextMsg.H"
 #include "WarpX.H"
 
@@ -63,9 +64,6 @@ void FiniteDifferenceSolver::ComputeCurlACylindrical (
     int lev
 )
 {
-    // for the profiler
-    amrex::LayoutData<amrex::Real>* cost = WarpX::getCosts(lev);
-
     // reset Bfield
     Bfield[0]->setVal(0);
     Bfield[1]->setVal(0);
@@ -76,11 +74,7 @@ void FiniteDifferenceSolver::ComputeCurlACylindrical (
 #pragma omp parallel if (amrex::Gpu::notInLaunchRegion())
 #endif
     for ( MFIter mfi(*Afield[0], TilingIfNotGPU()); mfi.isValid(); ++mfi ) {
-        if (cost && WarpX::load_balance_costs_update_algo == LoadBalanceCostsUpdateAlgo::Timers)
-        {
-            amrex::Gpu::synchronize();
-        }
-        Real wt = static_cast<Real>(amrex::second());
+        CostTimer cost_timer(lev, mfi.index());
 
         // Extract field data for this grid/tile
         Array4<const Real> const& Ar = Afield[0]->const_array(mfi);
@@ -189,12 +183,7 @@ void FiniteDifferenceSolver::ComputeCurlACylindrical (
             }
         );
 
-        if (cost && WarpX::load_balance_costs_update_algo == LoadBalanceCostsUpdateAlgo::Timers)
-        {
-            amrex::Gpu::synchronize();
-            wt = static_cast<Real>(amrex::second()) - wt;
-            amrex::HostDevice::Atomic::Add( &(*cost)[mfi.index()], wt);
-        }
+        cost_timer.record(KernelCost::FieldSolve);
     }
 }
 
@@ -210,9 +199,6 @@ void FiniteDifferenceSolver::ComputeCurlACartesian (
 {
     using ablastr::fields::Direction;
 
-    // for the profiler
-    amrex::LayoutData<amrex::Real>* cost = WarpX::getCosts(lev);
-
     // reset Bfield
     Bfield[0]->setVal(0);
     Bfield[1]->setVal(0);
@@ -223,10 +209,7 @@ void FiniteDifferenceSolver::ComputeCurlACartesian (
 #pragma omp parallel if (amrex::Gpu::notInLaunchRegion())
 #endif
     for ( MFIter mfi(*Afield[0], TilingIfNotGPU()); mfi.isValid(); ++mfi ) {
-        if (cost && WarpX::load_balance_costs_update_algo == LoadBalanceCostsUpdateAlgo::Timers) {
-            amrex::Gpu::synchronize();
-        }
-        auto wt = static_cast<amrex::Real>(amrex::second());
+        CostTimer cost_timer(lev, mfi.index());
 
         // Extract field data for this grid/tile
         Array4<Real> const &Bx = Bfield[0]->array(mfi);
@@ -295,12 +278,7 @@ void FiniteDifferenceSolver::ComputeCurlACartesian (
             }
         );
 
-        if (cost && WarpX::load_balance_costs_update_algo == LoadBalanceCostsUpdateAlgo::Timers)
-        {
-            amrex::Gpu::synchronize();
-            wt = static_cast<amrex::Real>(amrex::second()) - wt;
-            amrex::HostDevice::Atomic::Add( &(*cost)[mfi.index()], wt);
-        }
+        cost_timer.record(KernelCost::FieldSolve);
     }
 }
 #endif
@@ -6,6 +6,7 @@
  */
 #include "FiniteDifferenceSolver.H"
 
+#include "BoundaryConditions/FusedFieldBoundary.H"
 #include "EmbeddedBoundary/WarpXFaceInfoBox.H"
 #include "Fields.H"
 #ifndef WARPX_DIM_RZ
@@ -15,6 +16,7 @@
 #else
 #   include "FiniteDifferenceAlgorithms/CylindricalYeeAlgorithm.H"
 #endif
+#include "Parallelization/CostTimer.H"
 #include "Utils/TextMsg.H"
 #include "Utils/WarpXAlgorithmSelection.H"
 #include "Utils/WarpXConst.H"
@@ -54,7 +56,9 @@ void FiniteDifferenceSolver::EvolveB (
     PatchType patch_type,
     [[maybe_unused]] std::array< std::unique_ptr<amrex::iMultiFab>, 3 >& flag_info_cell,
     [[maybe_unused]] std::array< std::unique_ptr<amrex::LayoutData<FaceInfoBox> >, 3 >& borrowing,
-    [[maybe_unused]] amrex::Real const dt )
+    [[maybe_unused]] amrex::Real const dt,
+    [[maybe_unused]] amrex::IntVect const& ng_update,
+    [[maybe_unused]] FusedFieldBoundary const* fused_bc )
 {
 
     using ablastr::fields::Direction;
@@ -97,16 +101,16 @@ void FiniteDifferenceSolver::EvolveB (
 
     if (m_grid_type == GridType::Collocated) {
 
-        EvolveBCartesian <CartesianNodalAlgorithm> ( Bfield, Efield, Gfield, lev, dt );
+        EvolveBCartesian <CartesianNodalAlgorithm> ( Bfield, Efield, Gfield, lev, dt, ng_update, fused_bc );
 
     } else if ((m_fdtd_algo == ElectromagneticSolverAlgo::Yee) ||
                (m_fdtd_algo == ElectromagneticSolverAlgo::HybridPIC)) {
 
-        EvolveBCartesian <CartesianYeeAlgorithm> ( Bfield, Efield, Gfield, lev, dt );
+        EvolveBCartesian <CartesianYeeAlgorithm> ( Bfield, Efield, Gfield, lev, dt, ng_update, fused_bc );
 
     } else if (m_fdtd_algo == ElectromagneticSolverAlgo::CKC) {
 
-        EvolveBCartesian <CartesianCKCAlgorithm> ( Bfield, Efield, Gfield, lev, dt );
+        EvolveBCartesian <CartesianCKCAlgorithm> ( Bfield, Efield, Gfield, lev, dt, ng_update, fused_bc );
     } else if (m_fdtd_algo == ElectromagneticSolverAlgo::ECT) {
         EvolveBCartesianECT(Bfield, face_areas, area_mod, ECTRhofield, Venl, flag_info_cell,
                             borrowing, lev, dt);
@@ -124,20 +128,18 @@ void FiniteDifferenceSolver::EvolveBCartesian (
     ablastr::fields::VectorField const& Bfield,
     ablastr::fields::VectorField const& Efield,
     amrex::MultiFab const * Gfield,
-    int lev, amrex::Real const dt ) {
+    int lev, amrex::Real const dt,
+    amrex::IntVect const& ng_update,
+    FusedFieldBoundary const* fused_bc ) {
 
-    amrex::LayoutData<amrex::Real>* cost = WarpX::getCosts(lev);
+    amrex::Geometry const& geom = WarpX::GetInstance().Geom(lev);
 
     // Loop through the grids, and over the tiles within each grid
 #ifdef AMREX_USE_OMP
 #pragma omp parallel if (amrex::Gpu::notInLaunchRegion())
 #endif
     for ( MFIter mfi(*Bfield[0], TilingIfNotGPU()); mfi.isValid(); ++mfi ) {
-        if (cost && WarpX::load_balance_costs_update_algo == LoadBalanceCostsUpdateAlgo::Timers)
-        {
-            amrex::Gpu::synchronize();
-        }
-        auto wt = static_cast<amrex::Real>(amrex::second());
+        CostTimer cost_timer(lev, mfi.index());
 
         // Extract field data for this grid/tile
         Array4<Real> const& Bx = Bfield[0]->array(mfi);
@@ -156,9 +158,9 @@ void FiniteDifferenceSolver::EvolveBCartesian (
         auto const n_coefs_z = static_cast<int>(m_stencil_coefs_z.size());
 
         // Extract tileboxes for which to loop
-        Box const& tbx  = mfi.tilebox(Bfield[0]->ixType().toIntVect());
-        Box const& tby  = mfi.tilebox(Bfield[1]->ixType().toIntVect());
-        Box const& tbz  = mfi.tilebox(Bfield[2]->ixType().toIntVect());
+        Box const tbx = UpdateBox(mfi, Bfield[0]->ixType(), ng_update, geom);
+        Box const tby = UpdateBox(mfi, Bfield[1]->ixType(), ng_update, geom);
+        Box const tbz = UpdateBox(mfi, Bfield[2]->ixType(), ng_update, geom);
 
         // Loop over the cells and update the fields
         amrex::ParallelFor(tbx, tby, tbz,
@@ -209,12 +211,16 @@ void FiniteDifferenceSolver::EvolveBCartesian (
             );
         }
 
-        if (cost && WarpX::load_balance_costs_update_algo == LoadBalanceCostsUpdateAlgo::Timers)
-        {
-            amrex::Gpu::synchronize();
-            wt = static_cast<amrex::Real>(amrex::second()) - wt;
-            amrex::HostDevice::Atomic::Add( &(*cost)[mfi.index()], wt);
+        // Apply the boundary conditions while the tile is still in cache
+        if (fused_bc) {
+            fused_bc->ApplyToBfieldOnTile(mfi, Bfield);
+            if (fused_bc->silver_mueller) {
+                ApplySilverMuellerBoundaryOnTile(mfi, Efield, Bfield, fused_bc->domain_box,
+                    fused_bc->silver_mueller_dt, fused_bc->field_boundary_lo, fused_bc->field_boundary_hi);
+            }
         }
+
+        cost_timer.record(KernelCost::FieldSolve);
     }
 }
 
@@ -235,7 +241,6 @@ void FiniteDifferenceSolver::EvolveBCartesianECT (
         "EvolveBCartesianECT: Embedded Boundaries are only implemented in 2D3V and 3D3V");
 #endif
 
-    amrex::LayoutData<amrex::Real> *cost = WarpX::getCosts(lev);
 
     Venl[0]->setVal(0.);
     Venl[1]->setVal(0.);
@@ -247,10 +252,7 @@ void FiniteDifferenceSolver::EvolveBCartesianECT (
 #endif
     for (MFIter mfi(*Bfield[0]); mfi.isValid(); ++mfi) {
 
-        if (cost && WarpX::load_balance_costs_update_algo == LoadBalanceCostsUpdateAlgo::Timers) {
-            amrex::Gpu::synchronize();
-        }
-        auto wt = static_cast<amrex::Real>(amrex::second());
+        CostTimer cost_timer(lev, mfi.index());
 
         for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
             // Extract field data for this grid/tile
@@ -369,12 +371,7 @@ void FiniteDifferenceSolver::EvolveBCartesianECT (
             });
 
         }
-        if (cost && WarpX::load_balance_costs_update_algo == LoadBalanceCostsUpdateAlgo::Timers)
-        {
-            amrex::Gpu::synchronize();
-            wt = static_cast<amrex::Real>(amrex::second()) - wt;
-            amrex::HostDevice::Atomic::Add( &(*cost)[mfi.index()], wt);
-        }
+        cost_timer.record(KernelCost::FieldSolve);
     }
 #else
     amrex::ignore_unused(Bfield, face_areas, area_mod, ECTRhofield, Venl, flag_info_cell, borrowing,
@@ -390,18 +387,13 @@ void FiniteDifferenceSolver::EvolveBCylindrical (
     ablastr::fields::VectorField const& Efield,
     int lev, amrex::Real const dt ) {
 
-    amrex::LayoutData<amrex::Real>* cost = WarpX::getCosts(lev);
 
     // Loop through the grids, and over the tiles within each grid
 #ifdef AMREX_USE_OMP
 #pragma omp parallel if (amrex::Gpu::notInLaunchRegion())
 #endif
     for ( MFIter mfi(*Bfield[0], TilingIfNotGPU()); mfi.isValid(); ++mfi ) {
-        if (cost && WarpX::load_balance_costs_update_algo == LoadBalanceCostsUpdateAlgo::Timers)
-        {
-            amrex::Gpu::synchronize();
-        }
-        auto wt = static_cast<amrex::Real>(amrex::second());
+        CostTimer cost_timer(lev, mfi.index());
 
         // Extract field data for this grid/tile
         Array4<Real> const& Br = Bfield[0]->array(mfi);
@@ -490,12 +482,7 @@ void FiniteDifferenceSolver::EvolveBCylindrical (
 
         );
 
-        if (cost && WarpX::load_balance_costs_update_algo == LoadBalanceCostsUpdateAlgo::Timers)
-        {
-            amrex::Gpu::synchronize();
-            wt = static_cast<amrex::Real>(amrex::second()) - wt;
-            amrex::HostDevice::Atomic::Add( &(*cost)[mfi.index()], wt);
-        }
+        cost_timer.record(KernelCost::FieldSolve);
     }
 }
 
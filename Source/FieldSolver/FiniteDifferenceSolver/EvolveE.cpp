@@ -14,7 +14,9 @@
 #else
 #   include "FieldSolver/FiniteDifferenceSolver/FiniteDifferenceAlgorithms/CylindricalYeeAlgorithm.H"
 #endif
+#include "BoundaryConditions/FusedFieldBoundary.H"
 #include "EmbeddedBoundary/Enabled.H"
+#include "Parallelization/CostTimer.H"
 #include "Utils/TextMsg.H"
 #include "Utils/WarpXAlgorithmSelection.H"
 #include "Utils/WarpXConst.H"
@@ -56,7 +58,9 @@ void FiniteDifferenceSolver::EvolveE (
     PatchType patch_type,
     ablastr::fields::VectorField const& Efield,
     std::array< std::unique_ptr<amrex::iMultiFab>,3 > const& eb_update_E,
-    amrex::Real const dt
+    amrex::Real const dt,
+    [[maybe_unused]] amrex::IntVect const& ng_update,
+    [[maybe_unused]] FusedFieldBoundary const* fused_bc
 )
 {
     using ablastr::fields::Direction;
@@ -81,15 +85,15 @@ void FiniteDifferenceSolver::EvolveE (
 #else
     if (m_grid_type == GridType::Collocated) {
 
-        EvolveECartesian <CartesianNodalAlgorithm> ( Efield, Bfield, Jfield, eb_update_E, Ffield, lev, dt );
+        EvolveECartesian <CartesianNodalAlgorithm> ( Efield, Bfield, Jfield, eb_update_E, Ffield, lev, dt, ng_update, fused_bc );
 
     } else if (m_fdtd_algo == ElectromagneticSolverAlgo::Yee || m_fdtd_algo == ElectromagneticSolverAlgo::ECT) {
 
-        EvolveECartesian <CartesianYeeAlgorithm> ( Efield, Bfield, Jfield, eb_update_E, Ffield, lev, dt );
+        EvolveECartesian <CartesianYeeAlgorithm> ( Efield, Bfield, Jfield, eb_update_E, Ffield, lev, dt, ng_update, fused_bc );
 
     } else if (m_fdtd_algo == ElectromagneticSolverAlgo::CKC) {
 
-        EvolveECartesian <CartesianCKCAlgorithm> ( Efield, Bfield, Jfield, eb_update_E, Ffield, lev, dt );
+        EvolveECartesian <CartesianCKCAlgorithm> ( Efield, Bfield, Jfield, eb_update_E, Ffield, lev, dt, ng_update, fused_bc );
 
 #endif
     } else {
@@ -108,21 +112,19 @@ void FiniteDifferenceSolver::EvolveECartesian (
     ablastr::fields::VectorField const& Jfield,
     std::array< std::unique_ptr<amrex::iMultiFab>,3> const& eb_update_E,
     amrex::MultiFab const* Ffield,
-    int lev, amrex::Real const dt ) {
+    int lev, amrex::Real const dt,
+    amrex::IntVect const& ng_update,
+    FusedFieldBoundary const* fused_bc ) {
 
-    amrex::LayoutData<amrex::Real>* cost = WarpX::getCosts(lev);
     Real constexpr c2 = PhysConst::c * PhysConst::c;
+    amrex::Geometry const& geom = WarpX::GetInstance().Geom(lev);
 
     // Loop through the grids, and over the tiles within each grid
 #ifdef AMREX_USE_OMP
 #pragma omp parallel if (amrex::Gpu::notInLaunchRegion())
 #endif
     for ( MFIter mfi(*Efield[0], TilingIfNotGPU()); mfi.isValid(); ++mfi ) {
-        if (cost && WarpX::load_balance_costs_update_algo == LoadBalanceCostsUpdateAlgo::Timers)
-        {
-            amrex::Gpu::synchronize();
-        }
-        auto wt = static_cast<amrex::Real>(amrex::second());
+        CostTimer cost_timer(lev, mfi.index());
 
         // Extract field data for this grid/tile
         Array4<Real> const& Ex = Efield[0]->array(mfi);
@@ -152,9 +154,9 @@ void FiniteDifferenceSolver::EvolveECartesian (
         auto const n_coefs_z = static_cast<int>(m_stencil_coefs_z.size());
 
         // Extract tileboxes for which to loop
-        Box const& tex  = mfi.tilebox(Efield[0]->ixType().toIntVect());
-        Box const& tey  = mfi.tilebox(Efield[1]->ixType().toIntVect());
-        Box const& tez  = mfi.tilebox(Efield[2]->ixType().toIntVect());
+        Box const tex = UpdateBox(mfi, Efield[0]->ixType(), ng_update, geom);
+        Box const tey = UpdateBox(mfi, Efield[1]->ixType(), ng_update, geom);
+        Box const tez = UpdateBox(mfi, Efield[2]->ixType(), ng_update, geom);
 
         // Loop over the cells and update the fields
         amrex::ParallelFor(tex, tey, tez,
@@ -218,12 +220,10 @@ void FiniteDifferenceSolver::EvolveECartesian (
 
         }
 
-        if (cost && WarpX::load_balance_costs_update_algo == LoadBalanceCostsUpdateAlgo::Timers)
-        {
-            amrex::Gpu::synchronize();
-            wt = static_cast<amrex::Real>(amrex::second()) - wt;
-            amrex::HostDevice::Atomic::Add( &(*cost)[mfi.index()], wt);
-        }
+        // Apply the boundary conditions while the tile is still in cache
+        if (fused_bc) { fused_bc->ApplyToEfieldOnTile(mfi, Efield); }
+
+        cost_timer.record(KernelCost::FieldSolve);
     }
 
 }
@@ -239,18 +239,13 @@ void FiniteDifferenceSolver::EvolveECylindrical (
     amrex::MultiFab const* Ffield,
     int lev, amrex::Real const dt ) {
 
-    amrex::LayoutData<amrex::Real>* cost = WarpX::getCosts(lev);
 
     // Loop through the grids, and over the tiles within each grid
 #ifdef AMREX_USE_OMP
 #pragma omp parallel if (amrex::Gpu::notInLaunchRegion())
 #endif
     for ( MFIter mfi(*Efield[0], TilingIfNotGPU()); mfi.isValid(); ++mfi ) {
-        if (cost && WarpX::load_balance_costs_update_algo == LoadBalanceCostsUpdateAlgo::Timers)
-        {
-            amrex::Gpu::synchronize();
-        }
-        auto wt = static_cast<amrex::Real>(amrex::second());
+        CostTimer cost_timer(lev, mfi.index());
 
         // Extract field data for this grid/tile
         Array4<Real> const& Er = Efield[0]->array(mfi);
@@ -441,12 +436,7 @@ void FiniteDifferenceSolver::EvolveECylindrical (
 
         } // end of if condition for F
 
-        if (cost && WarpX::load_balance_costs_update_algo == LoadBalanceCostsUpdateAlgo::Timers)
-        {
-            amrex::Gpu::synchronize();
-            wt = static_cast<amrex::Real>(amrex::second()) - wt;
-            amrex::HostDevice::Atomic::Add( &(*cost)[mfi.index()], wt);
-        }
+        cost_timer.record(KernelCost::FieldSolve);
     } // end of loop over grid/tiles
 
 }
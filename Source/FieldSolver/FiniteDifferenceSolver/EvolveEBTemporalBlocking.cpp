@@ -0,0 +1,120 @@
+/* Copyright 2025 The WarpX Community
+ *
+ * This file is part of WarpX.
+ *
+ * License: BSD-3-Clause-LBNL
+ */
+#include "FiniteDifferenceSolver.H"
+
+#include "Fields.H"
+#ifndef WARPX_DIM_RZ
+#   include "FiniteDifferenceAlgorithms/CartesianYeeAlgorithm.H"
+#   include "FiniteDifferenceAlgorithms/CartesianCKCAlgorithm.H"
+#   include "TemporalBlocking.H"
+#endif
+#include "Parallelization/CostTimer.H"
+#include "Utils/TextMsg.H"
+#include "Utils/WarpXAlgorithmSelection.H"
+#include "WarpX.H"
+
+#include <ablastr/fields/MultiFabRegister.H>
+
+#include <AMReX.H>
+#include <AMReX_Array4.H>
+#include <AMReX_Box.H>
+#include <AMReX_Geometry.H>
+#include <AMReX_GpuControl.H>
+#include <AMReX_MFIter.H>
+#include <AMReX_MultiFab.H>
+#include <AMReX_REAL.H>
+
+#include <array>
+
+using namespace amrex;
+
+/**
+ * \brief Update B over half a timestep, E over one timestep and B over half a timestep
+ */
+void FiniteDifferenceSolver::EvolveEBTemporalBlocking (
+    [[maybe_unused]] ablastr::fields::MultiFabRegister& fields,
+    [[maybe_unused]] int lev,
+    [[maybe_unused]] amrex::Real const dt,
+    [[maybe_unused]] amrex::IntVect const& ng_update_B1,
+    [[maybe_unused]] amrex::IntVect const& ng_update_E,
+    [[maybe_unused]] amrex::IntVect const& ng_update_B2,
+    [[maybe_unused]] int block_size )
+{
+#ifdef WARPX_DIM_RZ
+    WARPX_ABORT_WITH_MESSAGE("EvolveEBTemporalBlocking: not available in RZ geometry");
+#else
+    using warpx::fields::FieldType;
+
+    const ablastr::fields::VectorField Efield = fields.get_alldirs(FieldType::Efield_fp, lev);
+    const ablastr::fields::VectorField Bfield = fields.get_alldirs(FieldType::Bfield_fp, lev);
+    const ablastr::fields::VectorField Jfield = fields.get_alldirs(FieldType::current_fp, lev);
+
+    if (m_grid_type != ablastr::utils::enums::GridType::Collocated &&
+        m_fdtd_algo == ElectromagneticSolverAlgo::Yee) {
+
+        EvolveEBTemporalBlockingCartesian <CartesianYeeAlgorithm> (
+            Efield, Bfield, Jfield, lev, dt, ng_update_B1, ng_update_E, ng_update_B2, block_size );
+
+    } else if (m_grid_type != ablastr::utils::enums::GridType::Collocated &&
+               m_fdtd_algo == ElectromagneticSolverAlgo::CKC) {
+
+        EvolveEBTemporalBlockingCartesian <CartesianCKCAlgorithm> (
+            Efield, Bfield, Jfield, lev, dt, ng_update_B1, ng_update_E, ng_update_B2, block_size );
+
+    } else {
+        WARPX_ABORT_WITH_MESSAGE("EvolveEBTemporalBlocking: only the staggered Yee and CKC solvers are supported");
+    }
+#endif
+}
+
+
+#ifndef WARPX_DIM_RZ
+
+template<typename T_Algo>
+void FiniteDifferenceSolver::EvolveEBTemporalBlockingCartesian (
+    ablastr::fields::VectorField const& Efield,
+    ablastr::fields::VectorField const& Bfield,
+    ablastr::fields::VectorField const& Jfield,
+    int lev, amrex::Real const dt,
+    amrex::IntVect const& ng_update_B1,
+    amrex::IntVect const& ng_update_E,
+    amrex::IntVect const& ng_update_B2,
+    int block_size ) {
+
+    amrex::Geometry const& geom = WarpX::GetInstance().Geom(lev);
+
+    CartesianStencilCoefs const stencil{
+        m_stencil_coefs_x.dataPtr(), static_cast<int>(m_stencil_coefs_x.size()),
+        m_stencil_coefs_y.dataPtr(), static_cast<int>(m_stencil_coefs_y.size()),
+        m_stencil_coefs_z.dataPtr(), static_cast<int>(m_stencil_coefs_z.size())};
+
+    // Loop through the grids: each box is swept as a whole, by slabs of planes,
+    // so that the cache reuse is along the last dimension of the box. The threads
+    // share each box (see EvolveEBTemporalBlockingBox), so that they are all busy
+    // even when there are fewer boxes than threads.
+    for ( MFIter mfi(*Bfield[0], false); mfi.isValid(); ++mfi ) {
+        CostTimer cost_timer(lev, mfi.index());
+
+        // Boxes updated by each sub-step, as in EvolveBCartesian and EvolveECartesian
+        std::array<Box, 3> tb_B1, tb_E, tb_B2;
+        for (int idir = 0; idir < 3; ++idir) {
+            tb_B1[idir] = UpdateBox(mfi, Bfield[idir]->ixType(), ng_update_B1, geom);
+            tb_E[idir] = UpdateBox(mfi, Efield[idir]->ixType(), ng_update_E, geom);
+            tb_B2[idir] = UpdateBox(mfi, Bfield[idir]->ixType(), ng_update_B2, geom);
+        }
+
+        EvolveEBTemporalBlockingBox<T_Algo>(
+            Efield[0]->array(mfi), Efield[1]->array(mfi), Efield[2]->array(mfi),
+            Bfield[0]->array(mfi), Bfield[1]->array(mfi), Bfield[2]->array(mfi),
+            Jfield[0]->const_array(mfi), Jfield[1]->const_array(mfi), Jfield[2]->const_array(mfi),
+            tb_B1, tb_E, tb_B2, stencil, dt, block_size);
+
+        cost_timer.record(KernelCost::FieldSolve);
+    }
+}
+
+#endif // corresponds to ifndef WARPX_DIM_RZ
@@ -20,7 +20,9 @@
 #endif
 
 #include <AMReX.H>
+#include <AMReX_Geometry.H>
 #include <AMReX_GpuDevice.H>
+#include <AMReX_MFIter.H>
 #include <AMReX_PODVector.H>
 #include <AMReX_Vector.H>
 
@@ -101,3 +103,25 @@ FiniteDifferenceSolver::FiniteDifferenceSolver (
     amrex::Gpu::synchronize();
 #endif
 }
+
+#ifndef WARPX_DIM_RZ
+amrex::Box
+FiniteDifferenceSolver::UpdateBox (
+    amrex::MFIter const& mfi,
+    amrex::IndexType const ixtype,
+    amrex::IntVect const& ng_update,
+    amrex::Geometry const& geom )
+{
+    if (ng_update == amrex::IntVect::TheZeroVector()) {
+        return mfi.tilebox(ixtype.toIntVect());
+    }
+
+    // The guard cells beyond the non-periodic boundaries are set by the
+    // field boundary conditions, not by the field solve
+    amrex::Box domain = geom.Domain();
+    for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+        if (geom.isPeriodic(idim)) { domain.grow(idim, ng_update[idim]); }
+    }
+    return mfi.tilebox(ixtype.toIntVect(), ng_update) & amrex::convert(domain, ixtype);
+}
+#endif
@@ -17,6 +17,7 @@
 #   include "FiniteDifferenceAlgorithms/CartesianYeeAlgorithm.H"
 #endif
 #include "HybridPICModel/HybridPICModel.H"
+#include "Parallelization/CostTimer.H"
 #include "Utils/TextMsg.H"
 #include "WarpX.H"
 
@@ -67,9 +68,6 @@ void FiniteDifferenceSolver::CalculateCurrentAmpereCylindrical (
     int lev
 )
 {
-    // for the profiler
-    amrex::LayoutData<amrex::Real>* cost = WarpX::getCosts(lev);
-
     // reset Jfield
     Jfield[0]->setVal(0);
     Jfield[1]->setVal(0);
@@ -80,11 +78,7 @@ void FiniteDifferenceSolver::CalculateCurrentAmpereCylindrical (
 #pragma omp parallel if (amrex::Gpu::notInLaunchRegion())
 #endif
     for ( MFIter mfi(*Jfield[0], TilingIfNotGPU()); mfi.isValid(); ++mfi ) {
-        if (cost && WarpX::load_balance_costs_update_algo == LoadBalanceCostsUpdateAlgo::Timers)
-        {
-            amrex::Gpu::synchronize();
-        }
-        Real wt = static_cast<Real>(amrex::second());
+        CostTimer cost_timer(lev, mfi.index());
 
         // Extract field data for this grid/tile
         Array4<Real> const& Jr = Jfield[0]->array(mfi);
@@ -240,12 +234,7 @@ void FiniteDifferenceSolver::CalculateCurrentAmpereCylindrical (
             }
         );
 
-        if (cost && WarpX::load_balance_costs_update_algo == LoadBalanceCostsUpdateAlgo::Timers)
-        {
-            amrex::Gpu::synchronize();
-            wt = static_cast<Real>(amrex::second()) - wt;
-            amrex::HostDevice::Atomic::Add( &(*cost)[mfi.index()], wt);
-        }
+        cost_timer.record(KernelCost::FieldSolve);
     }
 }
 
@@ -259,9 +248,6 @@ void FiniteDifferenceSolver::CalculateCurrentAmpereCartesian (
     int lev
 )
 {
-    // for the profiler
-    amrex::LayoutData<amrex::Real>* cost = WarpX::getCosts(lev);
-
     // reset Jfield
     Jfield[0]->setVal(0);
     Jfield[1]->setVal(0);
@@ -272,10 +258,7 @@ void FiniteDifferenceSolver::CalculateCurrentAmpereCartesian (
 #pragma omp parallel if (amrex::Gpu::notInLaunchRegion())
 #endif
     for ( MFIter mfi(*Jfield[0], TilingIfNotGPU()); mfi.isValid(); ++mfi ) {
-        if (cost && WarpX::load_balance_costs_update_algo == LoadBalanceCostsUpdateAlgo::Timers) {
-            amrex::Gpu::synchronize();
-        }
-        auto wt = static_cast<amrex::Real>(amrex::second());
+        CostTimer cost_timer(lev, mfi.index());
 
         // Extract field data for this grid/tile
         Array4<Real> const &Jx = Jfield[0]->array(mfi);
@@ -353,12 +336,7 @@ void FiniteDifferenceSolver::CalculateCurrentAmpereCartesian (
             }
         );
 
-        if (cost && WarpX::load_balance_costs_update_algo == LoadBalanceCostsUpdateAlgo::Timers)
-        {
-            amrex::Gpu::synchronize();
-            wt = static_cast<amrex::Real>(amrex::second()) - wt;
-            amrex::HostDevice::Atomic::Add( &(*cost)[mfi.index()], wt);
-        }
+        cost_timer.record(KernelCost::FieldSolve);
     }
 }
 #endif
@@ -418,9 +396,6 @@ void FiniteDifferenceSolver::HybridPICSolveECylindrical (
         (m_nmodes == 1),
         "Ohm's law solver only support m = 0 azimuthal mode at present.");
 
-    // for the profiler
-    amrex::LayoutData<amrex::Real>* cost = WarpX::getCosts(lev);
-
     using namespace ablastr::coarsen::sample;
 
     // get hybrid model parameters
@@ -481,11 +456,7 @@ void FiniteDifferenceSolver::HybridPICSolveECylindrical (
 #pragma omp parallel if (amrex::Gpu::notInLaunchRegion())
 #endif
     for ( MFIter mfi(enE_nodal_mf, TilingIfNotGPU()); mfi.isValid(); ++mfi ) {
-        if (cost && WarpX::load_balance_costs_update_algo == LoadBalanceCostsUpdateAlgo::Timers)
-        {
-            amrex::Gpu::synchronize();
-        }
-        Real wt = static_cast<Real>(amrex::second());
+        CostTimer cost_timer(lev, mfi.index());
 
         Array4<Real> const& enE_nodal = enE_nodal_mf.array(mfi);
         Array4<Real const> const& Jr = Jfield[0]->const_array(mfi);
@@ -544,12 +515,7 @@ void FiniteDifferenceSolver::HybridPICSolveECylindrical (
             );
         });
 
-        if (cost && WarpX::load_balance_costs_update_algo == LoadBalanceCostsUpdateAlgo::Timers)
-        {
-            amrex::Gpu::synchronize();
-            wt = static_cast<Real>(amrex::second()) - wt;
-            amrex::HostDevice::Atomic::Add( &(*cost)[mfi.index()], wt);
-        }
+        cost_timer.record(KernelCost::FieldSolve);
     }
 
     // Loop through the grids, and over the tiles within each grid again
@@ -558,11 +524,7 @@ void FiniteDifferenceSolver::HybridPICSolveECylindrical (
 #pragma omp parallel if (amrex::Gpu::notInLaunchRegion())
 #endif
     for ( MFIter mfi(*Efield[0], TilingIfNotGPU()); mfi.isValid(); ++mfi ) {
-        if (cost && WarpX::load_balance_costs_update_algo == LoadBalanceCostsUpdateAlgo::Timers)
-        {
-            amrex::Gpu::synchronize();
-        }
-        Real wt = static_cast<Real>(amrex::second());
+        CostTimer cost_timer(lev, mfi.index());
 
         // Extract field data for this grid/tile
         Array4<Real> const& Er = Efield[0]->array(mfi);
@@ -776,12 +738,7 @@ void FiniteDifferenceSolver::HybridPICSolveECylindrical (
             }
         );
 
-        if (cost && WarpX::load_balance_costs_update_algo == LoadBalanceCostsUpdateAlgo::Timers)
-        {
-            amrex::Gpu::synchronize();
-            wt = static_cast<Real>(amrex::second()) - wt;
-            amrex::HostDevice::Atomic::Add( &(*cost)[mfi.index()], wt);
-        }
+        cost_timer.record(KernelCost::FieldSolve);
     }
 }
 
@@ -799,9 +756,6 @@ void FiniteDifferenceSolver::HybridPICSolveECartesian (
     int lev, HybridPICModel const* hybrid_model,
     const bool solve_for_Faraday )
 {
-    // for the profiler
-    amrex::LayoutData<amrex::Real>* cost = WarpX::getCosts(lev);
-
     using namespace ablastr::coarsen::sample;
 
     // get hybrid model parameters
@@ -862,11 +816,7 @@ void FiniteDifferenceSolver::HybridPICSolveECartesian (
 #pragma omp parallel if (amrex::Gpu::notInLaunchRegion())
 #endif
     for ( MFIter mfi(enE_nodal_mf, TilingIfNotGPU()); mfi.isValid(); ++mfi ) {
-        if (cost && WarpX::load_balance_costs_update_algo == LoadBalanceCostsUpdateAlgo::Timers)
-        {
-            amrex::Gpu::synchronize();
-        }
-        auto wt = static_cast<amrex::Real>(amrex::second());
+        CostTimer cost_timer(lev, mfi.index());
 
         Array4<Real> const& enE_nodal = enE_nodal_mf.array(mfi);
         Array4<Real const> const& Jx = Jfield[0]->const_array(mfi);
@@ -925,12 +875,7 @@ void FiniteDifferenceSolver::HybridPICSolveECartesian (
             );
         });
 
-        if (cost && WarpX::load_balance_costs_update_algo == LoadBalanceCostsUpdateAlgo::Timers)
-        {
-            amrex::Gpu::synchronize();
-            wt = static_cast<amrex::Real>(amrex::second()) - wt;
-            amrex::HostDevice::Atomic::Add( &(*cost)[mfi.index()], wt);
-        }
+        cost_timer.record(KernelCost::FieldSolve);
     }
 
     // Loop through the grids, and over the tiles within each grid again
@@ -939,11 +884,7 @@ void FiniteDifferenceSolver::HybridPICSolveECartesian (
 #pragma omp parallel if (amrex::Gpu::notInLaunchRegion())
 #endif
     for ( MFIter mfi(*Efield[0], TilingIfNotGPU()); mfi.isValid(); ++mfi ) {
-        if (cost && WarpX::load_balance_costs_update_algo == LoadBalanceCostsUpdateAlgo::Timers)
-        {
-            amrex::Gpu::synchronize();
-        }
-        auto wt = static_cast<amrex::Real>(amrex::second());
+        CostTimer cost_timer(lev, mfi.index());
 
         // Extract field data for this grid/tile
         Array4<Real> const& Ex = Efield[0]->array(mfi);
@@ -1141,12 +1082,7 @@ void FiniteDifferenceSolver::HybridPICSolveECartesian (
             }
         );
 
-        if (cost && WarpX::load_balance_costs_update_algo == LoadBalanceCostsUpdateAlgo::Timers)
-        {
-            amrex::Gpu::synchronize();
-            wt = static_cast<amrex::Real>(amrex::second()) - wt;
-            amrex::HostDevice::Atomic::Add( &(*cost)[mfi.index()], wt);
-        }
+        cost_timer.record(KernelCost::FieldSolve);
     }
 }
 #endif
@@ -7,6 +7,7 @@
 #   include "FiniteDifferenceAlgorithms/CartesianCKCAlgorithm.H"
 #   include "FiniteDifferenceAlgorithms/FieldAccessorFunctors.H"
 #endif
+#include "BoundaryConditions/FusedFieldBoundary.H"
 #include "EmbeddedBoundary/Enabled.H"
 #include "MacroscopicProperties/MacroscopicProperties.H"
 #include "Utils/TextMsg.H"
@@ -42,7 +43,8 @@ void FiniteDifferenceSolver::MacroscopicEvolveE (
     ablastr::fields::VectorField const& Jfield,
     std::array< std::unique_ptr<amrex::iMultiFab>,3 > const& eb_update_E,
     amrex::Real const dt,
-    std::unique_ptr<MacroscopicProperties> const& macroscopic_properties)
+    std::unique_ptr<MacroscopicProperties> const& macroscopic_properties,
+    [[maybe_unused]] FusedFieldBoundary const* fused_bc)
 {
 
     // Select algorithm (The choice of algorithm is a runtime option,
@@ -61,13 +63,13 @@ void FiniteDifferenceSolver::MacroscopicEvolveE (
         if (WarpX::macroscopic_solver_algo == MacroscopicSolverAlgo::LaxWendroff) {
 
             MacroscopicEvolveECartesian <CartesianYeeAlgorithm, LaxWendroffAlgo>
-                       ( Efield, Bfield, Jfield, eb_update_E, dt, macroscopic_properties);
+                       ( Efield, Bfield, Jfield, eb_update_E, dt, macroscopic_properties, fused_bc);
 
         }
         if (WarpX::macroscopic_solver_algo == MacroscopicSolverAlgo::BackwardEuler) {
 
             MacroscopicEvolveECartesian <CartesianYeeAlgorithm, BackwardEulerAlgo>
-                       ( Efield, Bfield, Jfield, eb_update_E, dt, macroscopic_properties);
+                       ( Efield, Bfield, Jfield, eb_update_E, dt, macroscopic_properties, fused_bc);
 
         }
 
@@ -78,12 +80,12 @@ void FiniteDifferenceSolver::MacroscopicEvolveE (
         if (WarpX::macroscopic_solver_algo == MacroscopicSolverAlgo::LaxWendroff) {
 
             MacroscopicEvolveECartesian <CartesianCKCAlgorithm, LaxWendroffAlgo>
-                       ( Efield, Bfield, Jfield, eb_update_E, dt, macroscopic_properties);
+                       ( Efield, Bfield, Jfield, eb_update_E, dt, macroscopic_properties, fused_bc);
 
         } else if (WarpX::macroscopic_solver_algo == MacroscopicSolverAlgo::BackwardEuler) {
 
             MacroscopicEvolveECartesian <CartesianCKCAlgorithm, BackwardEulerAlgo>
-                       ( Efield, Bfield, Jfield, eb_update_E, dt, macroscopic_properties);
+                       ( Efield, Bfield, Jfield, eb_update_E, dt, macroscopic_properties, fused_bc);
 
         }
 
@@ -105,7 +107,8 @@ void FiniteDifferenceSolver::MacroscopicEvolveECartesian (
     ablastr::fields::VectorField const& Jfield,
     std::array< std::unique_ptr<amrex::iMultiFab>,3 > const& eb_update_E,
     amrex::Real const dt,
-    std::unique_ptr<MacroscopicProperties> const& macroscopic_properties)
+    std::unique_ptr<MacroscopicProperties> const& macroscopic_properties,
+    FusedFieldBoundary const* fused_bc)
 {
     amrex::MultiFab& sigma_mf = macroscopic_properties->getsigma_mf();
     amrex::MultiFab& epsilon_mf = macroscopic_properties->getepsilon_mf();
@@ -231,6 +234,9 @@ void FiniteDifferenceSolver::MacroscopicEvolveECartesian (
                                      ) - beta * jz(i, j, k);
             }
         );
+
+        // Apply the boundary conditions while the tile is still in cache
+        if (fused_bc) { fused_bc->ApplyToEfieldOnTile(mfi, Efield); }
     }
 }
 
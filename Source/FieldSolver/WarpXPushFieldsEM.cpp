@@ -8,6 +8,7 @@
  */
 #include "WarpX.H"
 
+#include "BoundaryConditions/FusedFieldBoundary.H"
 #include "BoundaryConditions/PML.H"
 #include "Evolve/WarpXDtType.H"
 #include "Fields.H"
@@ -904,17 +905,33 @@ WarpX::EvolveB (int lev, amrex::Real a_dt, DtType a_dt_type, amrex::Real start_t
 void
 WarpX::EvolveB (int lev, PatchType patch_type, amrex::Real a_dt, DtType a_dt_type, amrex::Real start_time)
 {
+    // With the deep halo, B is also advanced in the guard cells in which
+    // E is up-to-date on the whole stencil
+    amrex::IntVect ng_update = amrex::IntVect::TheZeroVector();
+    if (m_fdtd_deep_halo_steps > 1) {
+        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(m_ng_valid_E.allGE(guard_cells.ng_FieldSolver),
+            "EvolveB: not enough up-to-date guard cells of E for the deep halo field solve");
+        ng_update = amrex::min(m_ng_valid_E - guard_cells.ng_FieldSolver, m_ng_valid_B);
+        m_ng_valid_B = ng_update;
+    }
+
+    // Boundary conditions applied to each tile by the field solver
+    auto const fused_bc = GetFusedFieldBoundary(lev, patch_type, a_dt_type);
+    FusedFieldBoundary const* const fused_bc_ptr = fused_bc ? &(*fused_bc) : nullptr;
+
     // Evolve B field in regular cells
     if (patch_type == PatchType::fine) {
         m_fdtd_solver_fp[lev]->EvolveB( m_fields,
                                         lev,
                                         patch_type,
-                                        m_flag_info_face[lev], m_borrowing[lev], a_dt );
+                                        m_flag_info_face[lev], m_borrowing[lev], a_dt,
+                                        ng_update, fused_bc_ptr );
     } else {
         m_fdtd_solver_cp[lev]->EvolveB( m_fields,
                                         lev,
                                         patch_type,
-                                        m_flag_info_face[lev], m_borrowing[lev], a_dt );
+                                        m_flag_info_face[lev], m_borrowing[lev], a_dt,
+                                        amrex::IntVect::TheZeroVector(), fused_bc_ptr );
     }
 
     // Evolve B field in PML cells
@@ -929,7 +946,7 @@ WarpX::EvolveB (int lev, PatchType patch_type, amrex::Real a_dt, DtType a_dt_typ
     }
 
     amrex::Real const new_time = start_time + a_dt;
-    ApplyBfieldBoundary(lev, patch_type, a_dt_type, new_time);
+    ApplyBfieldBoundary(lev, patch_type, a_dt_type, new_time, fused_bc.has_value());
 }
 
 
@@ -959,6 +976,21 @@ WarpX::EvolveE (int lev, amrex::Real a_dt, amrex::Real start_time)
 void
 WarpX::EvolveE (int lev, PatchType patch_type, amrex::Real a_dt, amrex::Real start_time)
 {
+    // With the deep halo, E is also advanced in the guard cells in which
+    // B is up-to-date on the whole stencil. J is up-to-date in all its guard
+    // cells, since SumBoundaryJ sums the overlapping deposits in all of them.
+    amrex::IntVect ng_update = amrex::IntVect::TheZeroVector();
+    if (m_fdtd_deep_halo_steps > 1) {
+        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(m_ng_valid_B.allGE(guard_cells.ng_FieldSolver),
+            "EvolveE: not enough up-to-date guard cells of B for the deep halo field solve");
+        ng_update = amrex::min(m_ng_valid_B - guard_cells.ng_FieldSolver, m_ng_valid_E);
+        m_ng_valid_E = ng_update;
+    }
+
+    // Boundary conditions applied to each tile by the field solver
+    auto const fused_bc = GetFusedFieldBoundary(lev, patch_type, DtType::Full);
+    FusedFieldBoundary const* const fused_bc_ptr = fused_bc ? &(*fused_bc) : nullptr;
+
     // Evolve E field in regular cells
     if (patch_type == PatchType::fine) {
         m_fdtd_solver_fp[lev]->EvolveE( m_fields,
@@ -966,14 +998,16 @@ WarpX::EvolveE (int lev, PatchType patch_type, amrex::Real a_dt, amrex::Real sta
                                         patch_type,
                                         m_fields.get_alldirs(FieldType::Efield_fp, lev),
                                         m_eb_update_E[lev],
-                                        a_dt );
+                                        a_dt,
+                                        ng_update, fused_bc_ptr );
     } else {
         m_fdtd_solver_cp[lev]->EvolveE( m_fields,
                                         lev,
                                         patch_type,
                                         m_fields.get_alldirs(FieldType::Efield_cp, lev),
                                         m_eb_update_E[lev],
-                                        a_dt );
+                                        a_dt,
+                                        amrex::IntVect::TheZeroVector(), fused_bc_ptr );
     }
 
     // Evolve E field in PML cells
@@ -996,7 +1030,7 @@ WarpX::EvolveE (int lev, PatchType patch_type, amrex::Real a_dt, amrex::Real sta
     }
 
     amrex::Real const new_time = start_time + a_dt;
-    ApplyEfieldBoundary(lev, patch_type, new_time);
+    ApplyEfieldBoundary(lev, patch_type, new_time, fused_bc.has_value());
 
     // ECTRhofield must be recomputed at the very end of the Efield update to ensure
     // that ECTRhofield is consistent with Efield
@@ -1019,6 +1053,36 @@ WarpX::EvolveE (int lev, PatchType patch_type, amrex::Real a_dt, amrex::Real sta
 #endif
 }
 
+void
+WarpX::EvolveEBTemporalBlocking (amrex::Real a_dt)
+{
+    WARPX_PROFILE("WarpX::EvolveEBTemporalBlocking()");
+
+    const int lev = 0;
+    const amrex::IntVect& ng_solver = guard_cells.ng_FieldSolver;
+
+    // Guard cells in which each sub-step is advanced redundantly, as in EvolveB and EvolveE
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(m_ng_valid_E.allGE(ng_solver),
+        "EvolveEBTemporalBlocking: not enough up-to-date guard cells of E for the deep halo field solve");
+    const amrex::IntVect ng_update_B1 = (m_ng_valid_E - ng_solver).min(m_ng_valid_B);
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(ng_update_B1.allGE(ng_solver),
+        "EvolveEBTemporalBlocking: not enough up-to-date guard cells of B for the deep halo field solve");
+    const amrex::IntVect ng_update_E = (ng_update_B1 - ng_solver).min(m_ng_valid_E);
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(ng_update_E.allGE(ng_solver),
+        "EvolveEBTemporalBlocking: not enough up-to-date guard cells of E for the deep halo field solve");
+    const amrex::IntVect ng_update_B2 = (ng_update_E - ng_solver).min(ng_update_B1);
+    m_ng_valid_E = ng_update_E;
+    m_ng_valid_B = ng_update_B2;
+
+    m_fdtd_solver_fp[lev]->EvolveEBTemporalBlocking(
+        m_fields, lev, a_dt,
+        ng_update_B1, ng_update_E, ng_update_B2,
+        m_fdtd_temporal_block_size );
+
+    // All the field boundaries are periodic (see CanUseTemporalBlocking):
+    // there is no boundary condition to apply between the sub-steps
+}
+
 
 void
 WarpX::EvolveF (amrex::Real a_dt, DtType a_dt_type)
@@ -1157,12 +1221,17 @@ WarpX::MacroscopicEvolveE (int lev, PatchType patch_type, amrex::Real a_dt, amre
         "Macroscopic EvolveE is not implemented for lev>0, yet."
     );
 
+    // Boundary conditions applied to each tile by the field solver
+    auto const fused_bc = GetFusedFieldBoundary(lev, patch_type, DtType::Full);
+    FusedFieldBoundary const* const fused_bc_ptr = fused_bc ? &(*fused_bc) : nullptr;
+
     m_fdtd_solver_fp[lev]->MacroscopicEvolveE(
         m_fields.get_alldirs(FieldType::Efield_fp, lev),
         m_fields.get_alldirs(FieldType::Bfield_fp, lev),
         m_fields.get_alldirs(FieldType::current_fp, lev),
         m_eb_update_E[lev],
-        a_dt, m_macroscopic_properties);
+        a_dt, m_macroscopic_properties,
+        fused_bc_ptr);
 
     if (do_pml && pml[lev]->ok()) {
         if (patch_type == PatchType::fine) {
@@ -1183,7 +1252,7 @@ WarpX::MacroscopicEvolveE (int lev, PatchType patch_type, amrex::Real a_dt, amre
     }
 
     amrex::Real const new_time = start_time + a_dt;
-    ApplyEfieldBoundary(lev, patch_type, new_time);
+    ApplyEfieldBoundary(lev, patch_type, new_time, fused_bc.has_value());
 }
 
 void
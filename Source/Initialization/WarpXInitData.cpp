@@ -617,6 +617,9 @@ WarpX::InitData ()
         ExecutePythonCallback("afterInitatRestart");
     }
 
+    // Once the initial fields are computed, the particles can leave the boxes of the fields
+    InitParticleLayout();
+
     if (restart_chkfile.empty() || write_diagnostics_on_restart) {
         // Write full diagnostics before the first iteration.
         multi_diags->FilterComputePackFlush(istep[0] - 1);
@@ -1043,6 +1046,7 @@ WarpX::InitLevelData (int lev, Real /*time*/)
         const auto iarr = costs[lev]->IndexArray();
         for (const auto& i : iarr) {
             (*costs[lev])[i] = 0.0;
+            if (kernel_costs[lev]) { (*kernel_costs[lev])[i].fill(0.0_rt); }
             WarpX::setLoadBalanceEfficiency(lev, -1);
         }
     }
@@ -0,0 +1,42 @@
+/* Copyright 2025 The WarpX Community
+ *
+ * This file is part of WarpX.
+ *
+ * License: BSD-3-Clause-LBNL
+ */
+#include "CostTimer.H"
+
+#include "Utils/WarpXAlgorithmSelection.H"
+#include "WarpX.H"
+
+#include <ablastr/parallelization/ThreadClock.H>
+
+#include <AMReX_GpuAtomic.H>
+
+CostTimer::CostTimer (int lev, int box_index)
+{
+    if (lev < 0 || WarpX::load_balance_costs_update_algo != LoadBalanceCostsUpdateAlgo::Timers) { return; }
+
+    m_cost = WarpX::getCosts(lev);
+    if (!m_cost) { return; }
+
+    m_kernel_costs = WarpX::getKernelCosts(lev);
+    m_box_index = box_index;
+    m_start = ablastr::parallelization::thread_seconds();
+}
+
+void
+CostTimer::record (KernelCost kernel)
+{
+    if (!m_cost) { return; }
+
+    const auto wt = static_cast<amrex::Real>(ablastr::parallelization::thread_seconds() - m_start);
+    amrex::HostDevice::Atomic::Add( &(*m_cost)[m_box_index], wt);
+    if (m_kernel_costs) {
+        amrex::HostDevice::Atomic::Add(
+            &(*m_kernel_costs)[m_box_index][static_cast<int>(kernel)], wt);
+    }
+
+    // Do not count the update of the costs
+    m_start = ablastr::parallelization::thread_seconds();
+}
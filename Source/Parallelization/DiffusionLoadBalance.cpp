@@ -0,0 +1,105 @@
+/* Copyright 2025 The WarpX Community
+ *
+ * This file is part of WarpX.
+ *
+ * License: BSD-3-Clause-LBNL
+ */
+#include "DiffusionLoadBalance.H"
+
+#include <AMReX_Box.H>
+
+#include <algorithm>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+namespace
+{
+    amrex::Real
+    efficiency (amrex::Vector<double> const& load)
+    {
+        double total = 0.;
+        for (const auto l : load) { total += l; }
+        const double max_load = *std::max_element(load.begin(), load.end());
+        return (max_load > 0.) ? static_cast<amrex::Real>(total/load.size()/max_load) : amrex::Real(1);
+    }
+}
+
+amrex::Vector<int>
+warpx::load_balance::makeDiffusion (amrex::BoxArray const& ba,
+                                    amrex::Vector<int> const& pmap,
+                                    amrex::Vector<amrex::Real> const& costs,
+                                    amrex::Vector<amrex::Long> const& bytes,
+                                    int nprocs,
+                                    amrex::Real target_ratio,
+                                    amrex::Long max_bytes_moved,
+                                    amrex::Real& currentEfficiency,
+                                    amrex::Real& proposedEfficiency)
+{
+    const int nboxes = static_cast<int>(pmap.size());
+    amrex::Vector<int> new_pmap = pmap;
+
+    amrex::Vector<double> load(nprocs, 0.);
+    amrex::Vector<amrex::Vector<int>> rank_boxes(nprocs);
+    for (int b = 0; b < nboxes; ++b) {
+        load[pmap[b]] += costs[b];
+        rank_boxes[pmap[b]].push_back(b);
+    }
+    double total = 0.;
+    for (const auto l : load) { total += l; }
+    const double avg = total/nprocs;
+
+    currentEfficiency = efficiency(load);
+
+    amrex::Vector<char> moved(nboxes, 0);
+    amrex::Long bytes_moved = 0;
+
+    for (int iter = 0; iter < nboxes && avg > 0.; ++iter)
+    {
+        const auto src = static_cast<int>(std::distance(load.begin(),
+            std::max_element(load.begin(), load.end())));
+        if (load[src] <= target_ratio*avg) { break; }
+        const auto least_loaded = static_cast<int>(std::distance(load.begin(),
+            std::min_element(load.begin(), load.end())));
+
+        // Find the move that lowers the most the maximum cost of the two ranks
+        int best_box = -1;
+        int best_dst = -1;
+        double best_max = load[src];
+        for (const int b : rank_boxes[src])
+        {
+            if (moved[b] || costs[b] <= 0.) { continue; }
+            if (max_bytes_moved > 0 && bytes_moved + bytes[b] > max_bytes_moved) { continue; }
+
+            std::vector<int> candidates{least_loaded};
+            for (const auto& isect : ba.intersections(amrex::grow(ba[b], 1))) {
+                candidates.push_back(new_pmap[isect.first]);
+            }
+            for (const int dst : candidates)
+            {
+                if (dst == src) { continue; }
+                const double new_max = std::max(load[src] - costs[b], load[dst] + costs[b]);
+                if (new_max < best_max
+                    || (new_max == best_max && best_box >= 0 && bytes[b] < bytes[best_box]))
+                {
+                    best_max = new_max;
+                    best_box = b;
+                    best_dst = dst;
+                }
+            }
+        }
+        if (best_box < 0) { break; }
+
+        new_pmap[best_box] = best_dst;
+        load[src] -= costs[best_box];
+        load[best_dst] += costs[best_box];
+        auto& src_boxes = rank_boxes[src];
+        src_boxes.erase(std::find(src_boxes.begin(), src_boxes.end(), best_box));
+        rank_boxes[best_dst].push_back(best_box);
+        moved[best_box] = 1;
+        bytes_moved += bytes[best_box];
+    }
+
+    proposedEfficiency = efficiency(load);
+    return new_pmap;
+}
@@ -54,7 +54,8 @@ guardCellManager::Init (
     const int pml_ncell,
     const amrex::Vector<amrex::IntVect>& ref_ratios,
     const bool use_filter,
-    const amrex::IntVect& bilinear_filter_stencil_length)
+    const amrex::IntVect& bilinear_filter_stencil_length,
+    const int fdtd_deep_halo_steps)
 {
     // When using subcycling, the particles on the fine level perform two pushes
     // before being redistributed ; therefore, we need one extra guard cell
@@ -341,4 +342,22 @@ guardCellManager::Init (
             ng_MovingWindow[moving_window_dir] = 1;
         }
     }
+
+    // Deep halo: each FDTD step (B half-push, E push, B half-push) invalidates
+    // 2*ng_FieldSolver guard cells of E and B. When the guard cells are exchanged
+    // every k steps, they must thus contain enough cells for k-1 steps, followed
+    // by the field gather and one more field solve on the valid cells.
+    if (fdtd_deep_halo_steps > 1) {
+        const int k = fdtd_deep_halo_steps;
+        const amrex::IntVect ng_needed = amrex::max(ng_FieldGather, ng_UpdateAux);
+        ng_DeepHalo = amrex::max(ng_needed + (2*k-1)*ng_FieldSolver, (2*k+1)*ng_FieldSolver);
+        // The moving window typically shifts the fields by one cell per step,
+        // which invalidates one more guard cell in the moving direction
+        if (do_moving_window) {
+            ng_DeepHalo[moving_window_dir] += k-1;
+        }
+        ng_alloc_EB = amrex::max(ng_alloc_EB, ng_DeepHalo);
+        // J is exchanged in the guard cells in which E is updated
+        ng_alloc_J = amrex::max(ng_alloc_J, ng_DeepHalo);
+    }
 }
@@ -60,6 +60,9 @@ WarpX::UpdateAuxilaryData ()
 
     using ablastr::fields::Direction;
 
+    // The copy of E and B on the boxes of the particles is now out of date
+    m_particle_fields_need_copy = true;
+
     amrex::MultiFab *Bfield_aux_lvl0_0 = m_fields.get(FieldType::Bfield_aux, Direction{0}, 0);
 
     ablastr::fields::MultiLevelVectorField const& Bfield_fp = m_fields.get_mr_levels_alldirs(FieldType::Bfield_fp, finest_level);
@@ -826,6 +829,57 @@ WarpX::FillBoundaryB (const int lev, const PatchType patch_type, const amrex::In
     }
 }
 
+void
+WarpX::FillBoundaryEB_nowait (const amrex::IntVect ng)
+{
+    WARPX_PROFILE("WarpX::FillBoundaryEB_nowait()");
+
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(finest_level == 0 && !WarpX::do_single_precision_comms,
+        "FillBoundaryEB_nowait: only implemented for a single level and double precision comms");
+
+    const int lev = 0;
+    const std::array<amrex::MultiFab*,3> E = m_fields.get_alldirs(FieldType::Efield_fp, lev);
+    const std::array<amrex::MultiFab*,3> B = m_fields.get_alldirs(FieldType::Bfield_fp, lev);
+
+    // Exchange data between valid domain and PML
+    // Fill guard cells in PML
+    if (do_pml && pml[lev] && pml[lev]->ok())
+    {
+        const std::array<amrex::MultiFab*,3> E_pml = m_fields.get_alldirs(FieldType::pml_E_fp, lev);
+        const std::array<amrex::MultiFab*,3> B_pml = m_fields.get_alldirs(FieldType::pml_B_fp, lev);
+
+        pml[lev]->Exchange(E_pml, E, PatchType::fine, do_pml_in_domain);
+        pml[lev]->FillBoundary(E_pml, PatchType::fine, std::nullopt);
+        pml[lev]->Exchange(B_pml, B, PatchType::fine, do_pml_in_domain);
+        pml[lev]->FillBoundary(B_pml, PatchType::fine, std::nullopt);
+    }
+
+    // Post the messages for the guard cells in valid domain
+    const amrex::Periodicity& period = Geom(lev).periodicity();
+    for (amrex::MultiFab* mf : {E[0], E[1], E[2], B[0], B[1], B[2]})
+    {
+        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+            ng.allLE(mf->nGrowVect()),
+            "Error: in FillBoundaryEB_nowait, requested more guard cells than allocated");
+
+        const amrex::IntVect nghost = (m_safe_guard_cells) ? mf->nGrowVect() : ng;
+        ablastr::utils::communication::FillBoundary_nowait(*mf, nghost, period);
+    }
+}
+
+void
+WarpX::FillBoundaryEB_finish ()
+{
+    WARPX_PROFILE("WarpX::FillBoundaryEB_finish()");
+
+    const int lev = 0;
+    for (const FieldType field : {FieldType::Efield_fp, FieldType::Bfield_fp}) {
+        for (amrex::MultiFab* mf : m_fields.get_alldirs(field, lev)) {
+            ablastr::utils::communication::FillBoundary_finish(*mf);
+        }
+    }
+}
+
 void
 WarpX::FillBoundaryE_avg(int lev, IntVect ng)
 {
@@ -1065,6 +1119,8 @@ WarpX::FillBoundaryAux (int lev, IntVect ng)
     ablastr::fields::MultiLevelVectorField Efield_aux = m_fields.get_mr_levels_alldirs(FieldType::Efield_aux, finest_level);
     ablastr::fields::MultiLevelVectorField Bfield_aux = m_fields.get_mr_levels_alldirs(FieldType::Bfield_aux, finest_level);
 
+    m_particle_fields_need_copy = true;
+
     const amrex::Periodicity& period = Geom(lev).periodicity();
     ablastr::utils::communication::FillBoundary(*Efield_aux[lev][0], ng, WarpX::do_single_precision_comms, period);
     ablastr::utils::communication::FillBoundary(*Efield_aux[lev][1], ng, WarpX::do_single_precision_comms, period);
@@ -1400,6 +1456,14 @@ void WarpX::SumBoundaryJ (
 
     amrex::MultiFab& J = *current[lev][Direction{idim}];
 
+    const amrex::IntVect src_ngrow = SumBoundaryJGuardCells(J);
+    const int icomp = 0;
+    const int ncomp = J.nComp();
+    WarpXSumGuardCells(J, period, src_ngrow, icomp, ncomp);
+}
+
+amrex::IntVect WarpX::SumBoundaryJGuardCells (const amrex::MultiFab& J) const
+{
     const amrex::IntVect ng = J.nGrowVect();
     amrex::IntVect ng_depos_J = get_ng_depos_J();
 
@@ -1424,10 +1488,7 @@ void WarpX::SumBoundaryJ (
 
     ng_depos_J.min(ng);
 
-    const amrex::IntVect src_ngrow = ng_depos_J;
-    const int icomp = 0;
-    const int ncomp = J.nComp();
-    WarpXSumGuardCells(J, period, src_ngrow, icomp, ncomp);
+    return ng_depos_J;
 }
 
 void WarpX::SumBoundaryJ (
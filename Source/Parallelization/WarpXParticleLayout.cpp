@@ -0,0 +1,312 @@
+/* Copyright 2025 The WarpX Community
+ *
+ * This file is part of WarpX.
+ *
+ * License: BSD-3-Clause-LBNL
+ */
+#include "WarpX.H"
+
+#include "EmbeddedBoundary/Enabled.H"
+#include "Fields.H"
+#include "Particles/MultiParticleContainer.H"
+#include "Particles/WarpXParticleContainer.H"
+#include "Utils/TextMsg.H"
+#include "Utils/WarpXAlgorithmSelection.H"
+#include "Utils/WarpXProfilerWrapper.H"
+
+#include <ablastr/fields/MultiFabRegister.H>
+
+#include <AMReX.H>
+#include <AMReX_BoxArray.H>
+#include <AMReX_DistributionMapping.H>
+#include <AMReX_GpuLaunch.H>
+#include <AMReX_IntVect.H>
+#include <AMReX_LayoutData.H>
+#include <AMReX_MFIter.H>
+#include <AMReX_MultiFab.H>
+#include <AMReX_ParallelContext.H>
+#include <AMReX_ParallelDescriptor.H>
+#include <AMReX_Periodicity.H>
+#include <AMReX_REAL.H>
+#include <AMReX_Vector.H>
+#include <AMReX_iMultiFab.H>
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <string>
+
+using namespace amrex;
+
+namespace
+{
+    /** \brief Add `src`, including its guard cells, to the valid cells of `dst`
+     *
+     * The guard cells of `dst` are set to zero, and the nodal points that are shared
+     * by several boxes of `dst` are only kept in the box that owns them, so that `dst`
+     * can then be summed over the boxes (e.g. with WarpX::SyncCurrent) as if
+     * the particles had deposited directly on the boxes of `dst`.
+     *
+     * \param[in,out] dst field on the boxes of the fields
+     * \param[in] src field on the boxes of the particles
+     * \param[in,out] owner_mask cached owner mask of `dst`, rebuilt if `dst` changed layout
+     * \param[in] period periodicity of the domain
+     */
+    void
+    AddToValidCells (MultiFab& dst, MultiFab const& src,
+                     std::unique_ptr<iMultiFab>& owner_mask, Periodicity const& period)
+    {
+        dst.setVal(0.0_rt);
+        dst.ParallelAdd(src, 0, 0, dst.nComp(), src.nGrowVect(), IntVect::TheZeroVector(), period);
+
+        if (dst.ixType().cellCentered()) { return; }
+
+        if (!owner_mask || !isMFIterSafe(*owner_mask, dst)) {
+            owner_mask = amrex::OwnerMask(dst, period);
+        }
+#ifdef AMREX_USE_OMP
+#pragma omp parallel if (Gpu::notInLaunchRegion())
+#endif
+        for (MFIter mfi(dst, TilingIfNotGPU()); mfi.isValid(); ++mfi)
+        {
+            Array4<Real> const& arr = dst.array(mfi);
+            Array4<int const> const& owner = owner_mask->const_array(mfi);
+            ParallelFor(mfi.tilebox(), dst.nComp(),
+                [=] AMREX_GPU_DEVICE (int i, int j, int k, int n)
+                {
+                    if (!owner(i,j,k)) { arr(i,j,k,n) = 0.0_rt; }
+                });
+        }
+    }
+}
+
+void
+WarpX::InitParticleLayout ()
+{
+    if (!m_decouple_particle_layout) { return; }
+
+    WARPX_PROFILE("WarpX::InitParticleLayout()");
+
+#ifdef WARPX_DIM_RZ
+    WARPX_ABORT_WITH_MESSAGE("algo.decouple_particle_layout is not available in RZ geometry");
+#endif
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+        finest_level == 0 && evolve_scheme == EvolveScheme::Explicit &&
+        electrostatic_solver_id == ElectrostaticSolverAlgo::None &&
+        electromagnetic_solver_id != ElectromagneticSolverAlgo::None &&
+        electromagnetic_solver_id != ElectromagneticSolverAlgo::HybridPIC,
+        "algo.decouple_particle_layout requires a single level and an explicit electromagnetic solver");
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+        !do_multi_J && !m_overlap_guard_cell_exchange && !pml_has_particles && !EB::enabled(),
+        "algo.decouple_particle_layout is not compatible with warpx.do_multi_J, "
+        "warpx.overlap_guard_cell_exchange, warpx.pml_has_particles and embedded boundaries");
+
+    // The deposits in the guard cells beyond the domain boundaries are not sent back
+    // to the fields, and thus cannot be reflected into the domain
+    const auto is_reflecting_field = [](const FieldBoundaryType b) {
+        return b == FieldBoundaryType::PEC || b == FieldBoundaryType::PMC;
+    };
+    const auto is_reflecting_particle = [](const ParticleBoundaryType b) {
+        return b == ParticleBoundaryType::Reflecting || b == ParticleBoundaryType::Thermal;
+    };
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+        std::none_of(field_boundary_lo.begin(), field_boundary_lo.end(), is_reflecting_field) &&
+        std::none_of(field_boundary_hi.begin(), field_boundary_hi.end(), is_reflecting_field) &&
+        std::none_of(particle_boundary_lo.begin(), particle_boundary_lo.end(), is_reflecting_particle) &&
+        std::none_of(particle_boundary_hi.begin(), particle_boundary_hi.end(), is_reflecting_particle),
+        "algo.decouple_particle_layout is not compatible with pec/pmc field boundaries "
+        "and reflecting/thermal particle boundaries");
+
+    for (int i = 0; i < mypc->nContainers(); ++i) {
+        auto const& pc = mypc->GetParticleContainer(i);
+        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(!pc.DoFieldIonization() && !pc.DoQED(),
+            "algo.decouple_particle_layout is not compatible with field ionization and QED");
+    }
+
+    if (mypc->nContainers() == 0) { return; }
+
+    const int lev = 0;
+    BoxArray ba = boxArray(lev);
+    ba.maxSize((m_particle_max_grid_size > 0) ? IntVect(m_particle_max_grid_size) : maxGridSize(lev));
+    DistributionMapping dm{ba};
+
+    mypc->SetParticleBoxArray(lev, ba);
+    mypc->SetParticleDistributionMap(lev, dm);
+    mypc->Redistribute();
+    mypc->defineAllParticleTiles();
+    AllocParticleLayoutFields(lev);
+
+    // Balance the particle boxes right away, with the initial particles
+    LoadBalanceParticleLayout();
+}
+
+void
+WarpX::AllocParticleLayoutFields (int lev)
+{
+    using ablastr::fields::Direction;
+    using warpx::fields::FieldType;
+
+    auto const& pc = mypc->GetParticleContainer(0);
+    BoxArray const& ba = pc.ParticleBoxArray(lev);
+    DistributionMapping const& dm = pc.ParticleDistributionMap(lev);
+
+    m_particle_fields.clear_level(lev);
+    m_particle_fields_need_copy = true;
+
+    // The particles use the fields directly when they have the same boxes
+    if (ParticleLayoutMatchesFields(lev)) { return; }
+
+    // Same staggering, number of components and guard cells as the fields
+    for (auto const& name : {"Efield_aux", "Bfield_aux", "current_fp", "current_fp_nodal", "current_fp_vay"})
+    {
+        for (int idim = 0; idim < 3; ++idim)
+        {
+            if (!m_fields.has(name, Direction{idim}, lev)) { continue; }
+            MultiFab const& mf = *m_fields.get(name, Direction{idim}, lev);
+            m_particle_fields.alloc_init(name, Direction{idim}, lev,
+                amrex::convert(ba, mf.ixType()), dm, mf.nComp(), mf.nGrowVect(), 0.0_rt);
+        }
+    }
+    if (m_fields.has(FieldType::rho_fp, lev)) {
+        MultiFab const& rho = *m_fields.get(FieldType::rho_fp, lev);
+        m_particle_fields.alloc_init(FieldType::rho_fp, lev,
+            amrex::convert(ba, rho.ixType()), dm, rho.nComp(), rho.nGrowVect(), 0.0_rt);
+    }
+}
+
+bool
+WarpX::ParticleLayoutMatchesFields (int lev) const
+{
+    if (!m_decouple_particle_layout || mypc->nContainers() == 0) { return true; }
+
+    auto const& pc = mypc->GetParticleContainer(0);
+    return pc.ParticleBoxArray(lev) == boxArray(lev) &&
+           pc.ParticleDistributionMap(lev) == DistributionMap(lev);
+}
+
+ablastr::fields::MultiFabRegister&
+WarpX::GetParticleFields (int lev)
+{
+    if (ParticleLayoutMatchesFields(lev)) { return m_fields; }
+
+    // E and B (aux) did not change since they were last copied, e.g. between
+    // the half push of the momentum and the push of the first step
+    if (!m_particle_fields_need_copy) { return m_particle_fields; }
+
+    WARPX_PROFILE("WarpX::GetParticleFields()");
+
+    using ablastr::fields::Direction;
+    using warpx::fields::FieldType;
+
+    // The particles gather from at most ng_FieldGather guard cells
+    const IntVect ng = guard_cells.ng_FieldGather;
+    const Periodicity period = Geom(lev).periodicity();
+    for (auto const field : {FieldType::Efield_aux, FieldType::Bfield_aux})
+    {
+        for (int idim = 0; idim < 3; ++idim)
+        {
+            MultiFab const& src = *m_fields.get(field, Direction{idim}, lev);
+            m_particle_fields.get(field, Direction{idim}, lev)->ParallelCopy(
+                src, 0, 0, src.nComp(), ng, ng, period);
+        }
+    }
+    m_particle_fields_need_copy = false;
+    return m_particle_fields;
+}
+
+void
+WarpX::AddParticleLayoutDeposits (int lev, std::string const& current_fp_string)
+{
+    // The particles deposited directly on the fields when they have the same boxes
+    if (ParticleLayoutMatchesFields(lev)) { return; }
+
+    WARPX_PROFILE("WarpX::AddParticleLayoutDeposits()");
+
+    using ablastr::fields::Direction;
+    using warpx::fields::FieldType;
+
+    const Periodicity period = Geom(lev).periodicity();
+    for (int idim = 0; idim < 3; ++idim)
+    {
+        AddToValidCells(*m_fields.get(current_fp_string, Direction{idim}, lev),
+                        *m_particle_fields.get(current_fp_string, Direction{idim}, lev),
+                        m_particle_deposit_owner_masks[current_fp_string + std::to_string(idim)],
+                        period);
+    }
+    if (m_particle_fields.has(FieldType::rho_fp, lev)) {
+        AddToValidCells(*m_fields.get(FieldType::rho_fp, lev),
+                        *m_particle_fields.get(FieldType::rho_fp, lev),
+                        m_particle_deposit_owner_masks["rho_fp"],
+                        period);
+    }
+}
+
+void
+WarpX::LoadBalanceParticleLayout ()
+{
+#ifdef AMREX_USE_MPI
+    if (!m_decouple_particle_layout || mypc->nContainers() == 0) { return; }
+
+    WARPX_PROFILE("WarpX::LoadBalanceParticleLayout()");
+
+    const int lev = 0;
+    auto const& pc0 = mypc->GetParticleContainer(0);
+    BoxArray const& ba = pc0.ParticleBoxArray(lev);
+    DistributionMapping const& dm = pc0.ParticleDistributionMap(lev);
+
+    // The cost of a particle box is its number of particles
+    // (weighted by algo.costs_heuristic_species_wt, if provided)
+    LayoutData<Real> particle_costs(ba, dm);
+    for (MFIter mfi(particle_costs); mfi.isValid(); ++mfi) { particle_costs[mfi] = 0.0_rt; }
+    for (int i = 0; i < mypc->nContainers(); ++i)
+    {
+        auto& pc = mypc->GetParticleContainer(i);
+        const Real wt = (i < static_cast<int>(costs_heuristic_species_wt.size())) ?
+            costs_heuristic_species_wt[i] : 1.0_rt;
+        for (WarpXParIter pti(pc, lev); pti.isValid(); ++pti)
+        {
+            particle_costs[pti.index()] += wt*pti.numParticles();
+        }
+    }
+
+    const Real nboxes = ba.size();
+    const Real nprocs = ParallelContext::NProcsSub();
+    const int nmax = static_cast<int>(std::ceil(nboxes/nprocs*load_balance_knapsack_factor));
+    Real currentEfficiency = 0.0_rt;
+    Real proposedEfficiency = 0.0_rt;
+    DistributionMapping newdm = (load_balance_with_sfc)
+        ? DistributionMapping::makeSFC(particle_costs,
+                                       currentEfficiency, proposedEfficiency,
+                                       false,
+                                       ParallelDescriptor::IOProcessorNumber())
+        : DistributionMapping::makeKnapSack(particle_costs,
+                                            currentEfficiency, proposedEfficiency,
+                                            nmax,
+                                            false,
+                                            ParallelDescriptor::IOProcessorNumber());
+
+    int doLoadBalance = false;
+    if ((load_balance_efficiency_ratio_threshold > 0.0)
+        && (ParallelDescriptor::MyProc() == ParallelDescriptor::IOProcessorNumber())) {
+        doLoadBalance = (proposedEfficiency > load_balance_efficiency_ratio_threshold*currentEfficiency);
+    }
+    ParallelDescriptor::Bcast(&doLoadBalance, 1, ParallelDescriptor::IOProcessorNumber());
+    if (!doLoadBalance) { return; }
+
+    Vector<int> pmap;
+    if (ParallelDescriptor::MyProc() == ParallelDescriptor::IOProcessorNumber()) {
+        pmap = newdm.ProcessorMap();
+    } else {
+        pmap.resize(static_cast<std::size_t>(nboxes));
+    }
+    ParallelDescriptor::Bcast(pmap.data(), pmap.size(), ParallelDescriptor::IOProcessorNumber());
+    if (ParallelDescriptor::MyProc() != ParallelDescriptor::IOProcessorNumber()) {
+        newdm = DistributionMapping(pmap);
+    }
+
+    mypc->SetParticleDistributionMap(lev, newdm);
+    mypc->Redistribute();
+    mypc->defineAllParticleTiles();
+    AllocParticleLayoutFields(lev);
+#endif
+}
@@ -15,6 +15,7 @@
 #include "Fields.H"
 #include "FieldSolver/FiniteDifferenceSolver/HybridPICModel/HybridPICModel.H"
 #include "Initialization/ExternalField.H"
+#include "Parallelization/DiffusionLoadBalance.H"
 #include "Particles/MultiParticleContainer.H"
 #include "Particles/ParticleBoundaryBuffer.H"
 #include "Particles/WarpXParticleContainer.H"
@@ -23,6 +24,7 @@
 #include "Utils/WarpXProfilerWrapper.H"
 
 #include <ablastr/fields/MultiFabRegister.H>
+#include <ablastr/warn_manager/WarnManager.H>
 
 #include <AMReX.H>
 #include <AMReX_BLassert.H>
@@ -48,7 +50,10 @@
 #include <array>
 #include <cmath>
 #include <cstddef>
+#include <cstdint>
+#include <iterator>
 #include <memory>
+#include <sstream>
 #include <utility>
 #include <vector>
 
@@ -59,6 +64,14 @@ WarpX::CheckLoadBalance (int step)
 {
     if (step > 0 && load_balance_intervals.contains(step+1))
     {
+        if (costs_heuristic_calibrate)
+        {
+            AccumulateCostsCalibration();
+            if (step+1 >= costs_heuristic_calibration_steps) {
+                FinishCostsCalibration();
+            }
+        }
+
         LoadBalance();
 
         // Reset the costs to 0
@@ -105,28 +118,61 @@ WarpX::LoadBalance ()
         amrex::Real currentEfficiency = 0.0;
         amrex::Real proposedEfficiency = 0.0;
 
-        newdm = (load_balance_with_sfc)
-            ? DistributionMapping::makeSFC(*costs[lev],
-                                           currentEfficiency, proposedEfficiency,
-                                           false,
-                                           ParallelDescriptor::IOProcessorNumber())
-            : DistributionMapping::makeKnapSack(*costs[lev],
-                                                currentEfficiency, proposedEfficiency,
-                                                nmax,
-                                                false,
-                                                ParallelDescriptor::IOProcessorNumber());
-        // As specified in the above calls to makeSFC and makeKnapSack, the new
+        if (load_balance_with_diffusion)
+        {
+            // Gather the costs and the size of the boxes on root
+            Vector<Real> costs_vec;
+            Vector<Long> bytes_vec;
+            ParallelDescriptor::GatherLayoutDataToVector(*costs[lev], costs_vec,
+                                                         ParallelDescriptor::IOProcessorNumber());
+            ParallelDescriptor::GatherLayoutDataToVector(ComputeBoxRemakeBytes(lev), bytes_vec,
+                                                         ParallelDescriptor::IOProcessorNumber());
+            if (ParallelDescriptor::MyProc() == ParallelDescriptor::IOProcessorNumber())
+            {
+                newdm = DistributionMapping(warpx::load_balance::makeDiffusion(
+                    boxArray(lev), DistributionMap(lev).ProcessorMap(), costs_vec, bytes_vec,
+                    static_cast<int>(nprocs), load_balance_efficiency_ratio_threshold,
+                    static_cast<Long>(load_balance_max_bytes_moved),
+                    currentEfficiency, proposedEfficiency));
+            }
+        }
+        else
+        {
+            newdm = (load_balance_with_sfc)
+                ? DistributionMapping::makeSFC(*costs[lev],
+                                               currentEfficiency, proposedEfficiency,
+                                               false,
+                                               ParallelDescriptor::IOProcessorNumber())
+                : DistributionMapping::makeKnapSack(*costs[lev],
+                                                    currentEfficiency, proposedEfficiency,
+                                                    nmax,
+                                                    false,
+                                                    ParallelDescriptor::IOProcessorNumber());
+        }
+        // As specified in the above calls to makeSFC, makeKnapSack and makeDiffusion, the new
         // distribution mapping is NOT communicated to all ranks; the loadbalanced
         // dm is up-to-date only on root, and we can decide whether to broadcast
         if ((load_balance_efficiency_ratio_threshold > 0.0)
             && (ParallelDescriptor::MyProc() == ParallelDescriptor::IOProcessorNumber()))
         {
-            doLoadBalance = (proposedEfficiency > load_balance_efficiency_ratio_threshold*currentEfficiency);
+            // The diffusion strategy already stops at the threshold, so any gain is taken
+            doLoadBalance = (load_balance_with_diffusion)
+                ? (proposedEfficiency > currentEfficiency)
+                : (proposedEfficiency > load_balance_efficiency_ratio_threshold*currentEfficiency);
         }
 
         ParallelDescriptor::Bcast(&doLoadBalance, 1,
                                   ParallelDescriptor::IOProcessorNumber());
 
+        // The efficiencies are only computed on root
+        amrex::Real efficiencies[2] = {currentEfficiency, proposedEfficiency};
+        ParallelDescriptor::Bcast(efficiencies, 2, ParallelDescriptor::IOProcessorNumber());
+        currentEfficiency = efficiencies[0];
+        proposedEfficiency = efficiencies[1];
+
+        // Efficiency achieved by the current distribution mapping
+        load_balance_efficiency_achieved[lev] = currentEfficiency;
+
         if (doLoadBalance)
         {
             Vector<int> pmap;
@@ -165,9 +211,39 @@ WarpX::LoadBalance ()
         //multi_diags->LoadBalance();
         reduced_diags->LoadBalance();
     }
+
+    // The particles with their own boxes are balanced separately
+    LoadBalanceParticleLayout();
 #endif
 }
 
+amrex::LayoutData<amrex::Long>
+WarpX::ComputeBoxRemakeBytes (int lev)
+{
+    amrex::LayoutData<amrex::Long> bytes(boxArray(lev), DistributionMap(lev));
+    for (const auto& i : bytes.IndexArray())
+    {
+        bytes[i] = m_fields.remake_bytes(lev, i);
+    }
+
+    // The particles with their own boxes do not move with the fields
+    if (m_decouple_particle_layout) { return bytes; }
+
+    const auto & mypc_ref = GetPartContainer();
+    for (int i_s = 0; i_s < mypc_ref.nSpecies(); ++i_s)
+    {
+        auto & myspc = mypc_ref.GetParticleContainer(i_s);
+        const auto bytes_per_particle = static_cast<amrex::Long>(
+            myspc.NumRealComps()*sizeof(amrex::ParticleReal)
+            + myspc.NumIntComps()*sizeof(int) + sizeof(uint64_t));
+        for (WarpXParIter pti(myspc, lev); pti.isValid(); ++pti)
+        {
+            bytes[pti.index()] += bytes_per_particle*pti.numParticles();
+        }
+    }
+    return bytes;
+}
+
 void
 WarpX::RemakeLevel (int lev, Real /*time*/, const BoxArray& ba, const DistributionMapping& dm)
 {
@@ -187,7 +263,16 @@ WarpX::RemakeLevel (int lev, Real /*time*/, const BoxArray& ba, const Distributi
     {
         if (ParallelDescriptor::NProcs() == 1) { return; }
 
-        m_fields.remake_level(lev, dm);
+        // The fields are moved box by box, through bounded staging buffers
+        amrex::Long peak_bytes = m_fields.remake_level(
+            lev, dm, static_cast<amrex::Long>(load_balance_max_staging_bytes));
+        ParallelDescriptor::ReduceLongMax(peak_bytes, ParallelDescriptor::IOProcessorNumber());
+        if (verbose) {
+            std::stringstream ss;
+            ss << "Load balancing: peak memory of the fields while remaking level " << lev
+               << ": " << static_cast<double>(peak_bytes)/(1024.*1024.) << " MiB per MPI process (max)";
+            amrex::Print() << Utils::TextMsg::Info(ss.str());
+        }
 
         // Fine patch
         ablastr::fields::MultiLevelVectorField const& Bfield_fp = m_fields.get_mr_levels_alldirs(FieldType::Bfield_fp, finest_level);
@@ -307,6 +392,12 @@ WarpX::RemakeLevel (int lev, Real /*time*/, const BoxArray& ba, const Distributi
                 (*costs[lev])[i] = 0.0;
                 setLoadBalanceEfficiency(lev, -1);
             }
+
+            kernel_costs[lev] = std::make_unique<LayoutData<KernelCosts>>(ba, dm);
+            for (const auto& i : kernel_costs[lev]->IndexArray())
+            {
+                (*kernel_costs[lev])[i].fill(0.0_rt);
+            }
         }
 
         SetDistributionMap(lev, dm);
@@ -334,15 +425,22 @@ WarpX::ComputeCostsHeuristic (amrex::Vector<std::unique_ptr<amrex::LayoutData<am
         const auto & mypc_ref = GetPartContainer();
         const auto nSpecies = mypc_ref.nSpecies();
 
-        // Species loop
-        for (int i_s = 0; i_s < nSpecies; ++i_s)
+        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+            costs_heuristic_species_wt.empty()
+            || static_cast<int>(costs_heuristic_species_wt.size()) == nSpecies,
+            "algo.costs_heuristic_species_wt must have one value per species");
+
+        // Species loop (the particles with their own boxes are balanced separately)
+        for (int i_s = 0; i_s < nSpecies && !m_decouple_particle_layout; ++i_s)
         {
             auto & myspc = mypc_ref.GetParticleContainer(i_s);
+            const amrex::Real particles_wt = costs_heuristic_species_wt.empty() ?
+                costs_heuristic_particles_wt : costs_heuristic_species_wt[i_s];
 
             // Particle loop
             for (WarpXParIter pti(myspc, lev); pti.isValid(); ++pti)
             {
-                (*a_costs[lev])[pti.index()] += costs_heuristic_particles_wt*pti.numParticles();
+                (*a_costs[lev])[pti.index()] += particles_wt*pti.numParticles();
             }
         }
 
@@ -356,6 +454,186 @@ WarpX::ComputeCostsHeuristic (amrex::Vector<std::unique_ptr<amrex::LayoutData<am
     }
 }
 
+namespace
+{
+    /** \brief Non-negative least-squares solution of the normal equations ata*w = atb
+     *
+     * The unknowns that would get a negative value are removed one at a time
+     * (and set to 0), and the system is solved again for the remaining ones.
+     *
+     * \param[in] ata matrix A^T A, of size n*n (row major)
+     * \param[in] atb vector A^T b, of size n
+     * \return the n weights; all 0 if no weight could be fitted
+     */
+    amrex::Vector<double>
+    SolveNonNegativeLeastSquares (amrex::Vector<double> const& ata, amrex::Vector<double> const& atb)
+    {
+        const int n = static_cast<int>(atb.size());
+        amrex::Vector<double> w(n, 0.);
+
+        // Unknowns without data (e.g. species without particles) are not fitted
+        amrex::Vector<int> active(n);
+        for (int j = 0; j < n; ++j) { active[j] = (ata[j*n+j] > 0.) ? 1 : 0; }
+
+        for (int iter = 0; iter < n; ++iter)
+        {
+            amrex::Vector<int> idx;
+            for (int j = 0; j < n; ++j) { if (active[j]) { idx.push_back(j); } }
+            const int m = static_cast<int>(idx.size());
+            if (m == 0) { break; }
+
+            // Reduced system, with a small regularization in case of collinear unknowns
+            amrex::Vector<double> a(m*m), b(m);
+            for (int r = 0; r < m; ++r) {
+                for (int c = 0; c < m; ++c) { a[r*m+c] = ata[idx[r]*n+idx[c]]; }
+                a[r*m+r] *= 1. + 1.e-9;
+                b[r] = atb[idx[r]];
+            }
+
+            // Gaussian elimination with partial pivoting
+            for (int c = 0; c < m; ++c) {
+                int piv = c;
+                for (int r = c+1; r < m; ++r) {
+                    if (std::abs(a[r*m+c]) > std::abs(a[piv*m+c])) { piv = r; }
+                }
+                if (a[piv*m+c] == 0.) { return amrex::Vector<double>(n, 0.); }
+                if (piv != c) {
+                    for (int k = 0; k < m; ++k) { std::swap(a[c*m+k], a[piv*m+k]); }
+                    std::swap(b[c], b[piv]);
+                }
+                for (int r = c+1; r < m; ++r) {
+                    const double f = a[r*m+c]/a[c*m+c];
+                    for (int k = c; k < m; ++k) { a[r*m+k] -= f*a[c*m+k]; }
+                    b[r] -= f*b[c];
+                }
+            }
+            amrex::Vector<double> x(m);
+            for (int r = m-1; r >= 0; --r) {
+                double sum = b[r];
+                for (int k = r+1; k < m; ++k) { sum -= a[r*m+k]*x[k]; }
+                x[r] = sum/a[r*m+r];
+            }
+
+            // Remove the most negative unknown, if any, and solve again
+            const auto most_negative = std::min_element(x.begin(), x.end());
+            if (*most_negative >= 0.) {
+                for (int r = 0; r < m; ++r) { w[idx[r]] = x[r]; }
+                break;
+            }
+            active[idx[std::distance(x.begin(), most_negative)]] = 0;
+        }
+        return w;
+    }
+}
+
+void
+WarpX::AccumulateCostsCalibration ()
+{
+    using ablastr::fields::Direction;
+    using warpx::fields::FieldType;
+
+    const auto & mypc_ref = GetPartContainer();
+    const int nSpecies = mypc_ref.nSpecies();
+
+    // Unknowns: weight of the cells, then weight of the particles of each species
+    const int nw = nSpecies + 1;
+    amrex::Vector<double> ata(nw*nw, 0.);
+    amrex::Vector<double> atb(nw, 0.);
+
+    for (int lev = 0; lev <= finest_level; ++lev)
+    {
+        // Number of cells and of particles of each species in each box
+        amrex::LayoutData<amrex::Vector<double>> features(costs[lev]->boxArray(),
+                                                          costs[lev]->DistributionMap());
+        for (const auto& i : features.IndexArray()) { features[i].assign(nw, 0.); }
+
+        MultiFab* Ex = m_fields.get(FieldType::Efield_fp, Direction{0}, lev);
+        for (MFIter mfi(*Ex, false); mfi.isValid(); ++mfi)
+        {
+            features[mfi.index()][0] += static_cast<double>(mfi.growntilebox().numPts());
+        }
+        for (int i_s = 0; i_s < nSpecies; ++i_s)
+        {
+            auto & myspc = mypc_ref.GetParticleContainer(i_s);
+            for (WarpXParIter pti(myspc, lev); pti.isValid(); ++pti)
+            {
+                features[pti.index()][i_s+1] += static_cast<double>(pti.numParticles());
+            }
+        }
+
+        // Each box is one sample of the fit: cost = features . weights
+        for (const auto& i : features.IndexArray())
+        {
+            const auto& x = features[i];
+            const auto y = static_cast<double>((*costs[lev])[i]);
+            for (int a = 0; a < nw; ++a) {
+                atb[a] += x[a]*y;
+                for (int b = 0; b < nw; ++b) { ata[a*nw+b] += x[a]*x[b]; }
+            }
+        }
+    }
+
+    ParallelDescriptor::ReduceRealSum(ata.data(), static_cast<int>(ata.size()));
+    ParallelDescriptor::ReduceRealSum(atb.data(), static_cast<int>(atb.size()));
+
+    costs_calibration_ata.resize(nw*nw, 0.);
+    costs_calibration_atb.resize(nw, 0.);
+    for (int a = 0; a < nw*nw; ++a) { costs_calibration_ata[a] += ata[a]; }
+    for (int a = 0; a < nw; ++a) { costs_calibration_atb[a] += atb[a]; }
+}
+
+void
+WarpX::FinishCostsCalibration ()
+{
+    const amrex::Vector<double> w =
+        SolveNonNegativeLeastSquares(costs_calibration_ata, costs_calibration_atb);
+    const int nw = static_cast<int>(w.size());
+    const int nSpecies = nw - 1;
+
+    // A weight is fitted if its unknown has data (e.g. the species had particles
+    // during the calibration). A fitted weight of 0 is kept: the fit found no cost
+    // for these particles. The species without data get the mean fitted species weight.
+    auto const has_data = [&] (int j) { return costs_calibration_ata[j*nw+j] > 0.; };
+    double mean_species_wt = 0.;
+    int n_fitted = 0;
+    for (int i_s = 0; i_s < nSpecies; ++i_s) {
+        if (has_data(i_s+1)) { mean_species_wt += w[i_s+1]; ++n_fitted; }
+    }
+    if (n_fitted > 0) { mean_species_wt /= n_fitted; }
+
+    // The solver returns only zeros if the fit failed
+    if (std::any_of(w.begin(), w.end(), [] (double wt) { return wt > 0.; }))
+    {
+        costs_heuristic_cells_wt = static_cast<amrex::Real>(w[0]);
+        costs_heuristic_species_wt.resize(nSpecies);
+        for (int i_s = 0; i_s < nSpecies; ++i_s) {
+            costs_heuristic_species_wt[i_s] =
+                static_cast<amrex::Real>(has_data(i_s+1) ? w[i_s+1] : mean_species_wt);
+        }
+
+        std::stringstream ss;
+        ss << "Load balancing: heuristic costs weights fitted on the timers"
+           << " (particle shape " << WarpX::nox << "):\n"
+           << "    algo.costs_heuristic_cells_wt = " << costs_heuristic_cells_wt << "\n"
+           << "    algo.costs_heuristic_species_wt =";
+        for (const auto wt : costs_heuristic_species_wt) { ss << " " << wt; }
+        amrex::Print() << Utils::TextMsg::Info(ss.str());
+    }
+    else
+    {
+        ablastr::warn_manager::WMRecordWarning("Load balancing",
+            "The heuristic costs weights could not be fitted on the timers; "
+            "the default weights are used instead.");
+    }
+
+    // From now on, the costs are computed with the heuristic
+    costs_heuristic_calibrate = false;
+    costs_calibration_ata.clear();
+    costs_calibration_atb.clear();
+    WarpX::load_balance_costs_update_algo = LoadBalanceCostsUpdateAlgo::Heuristic;
+    ResetCosts();
+}
+
 void
 WarpX::ResetCosts ()
 {
@@ -369,6 +647,7 @@ WarpX::ResetCosts ()
         {
             // Reset costs
             (*costs[lev])[i] = 0.0;
+            if (kernel_costs[lev]) { (*kernel_costs[lev])[i].fill(0.0_rt); }
         }
     }
 }
@@ -392,9 +671,13 @@ WarpX::RescaleCosts (int step)
             // (Giving more importance to most recent costs; only needed
             // for timers update, heuristic load balance considers the
             // instantaneous costs)
+            const amrex::Real factor = 1._rt - 2._rt/load_balance_intervals.localPeriod(step+1);
             for (const auto& i : costs[lev]->IndexArray())
             {
-                (*costs[lev])[i] *= (1._rt - 2._rt/load_balance_intervals.localPeriod(step+1));
+                (*costs[lev])[i] *= factor;
+                if (kernel_costs[lev]) {
+                    for (auto& c : (*kernel_costs[lev])[i]) { c *= factor; }
+                }
             }
         }
     }
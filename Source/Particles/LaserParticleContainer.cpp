@@ -12,6 +12,7 @@
 #include "Evolve/WarpXPushType.H"
 #include "Fields.H"
 #include "Laser/LaserProfiles.H"
+#include "Parallelization/CostTimer.H"
 #include "Particles/LaserParticleContainer.H"
 #include "Particles/Pusher/GetAndSetPosition.H"
 #include "Particles/WarpXParticleContainer.H"
@@ -560,7 +561,8 @@ void
 LaserParticleContainer::Evolve (ablastr::fields::MultiFabRegister& fields,
                                 int lev,
                                 const std::string& current_fp_string,
-                                Real t, Real dt, DtType /*a_dt_type*/, bool skip_deposition, PushType push_type)
+                                Real t, Real dt, DtType /*a_dt_type*/, bool skip_deposition, PushType push_type,
+                                PushRegion push_region)
 {
     using ablastr::fields::Direction;
     using warpx::fields::FieldType;
@@ -570,6 +572,9 @@ LaserParticleContainer::Evolve (ablastr::fields::MultiFabRegister& fields,
 
     if (!m_enabled) { return; }
 
+    // The antenna does not gather the fields: all its particles are pushed with the interior ones
+    if (push_region == PushRegion::Boundary) { return; }
+
     Real t_lab = t;
     if (WarpX::gamma_boost > 1) {
         // Convert time from the boosted to the lab-frame
@@ -583,8 +588,6 @@ LaserParticleContainer::Evolve (ablastr::fields::MultiFabRegister& fields,
 
     BL_ASSERT(OnSameGrids(lev, *fields.get(FieldType::current_fp, Direction{0}, lev)));
 
-    amrex::LayoutData<amrex::Real>* cost = WarpX::getCosts(lev);
-
     const bool has_rho = fields.has(FieldType::rho_fp, lev);
     const bool has_buffer = fields.has_vector(FieldType::current_buf, lev);
 
@@ -602,11 +605,7 @@ LaserParticleContainer::Evolve (ablastr::fields::MultiFabRegister& fields,
 
         for (WarpXParIter pti(*this, lev); pti.isValid(); ++pti)
         {
-            if (cost && WarpX::load_balance_costs_update_algo == LoadBalanceCostsUpdateAlgo::Timers)
-            {
-                amrex::Gpu::synchronize();
-            }
-            Real wt = static_cast<Real>(amrex::second());
+            CostTimer cost_timer(lev, pti.index());
 
             auto& attribs = pti.GetAttribs();
 
@@ -638,6 +637,8 @@ LaserParticleContainer::Evolve (ablastr::fields::MultiFabRegister& fields,
                 }
             }
 
+            cost_timer.record(KernelCost::Deposition);
+
             //
             // Particle Push
             //
@@ -659,6 +660,8 @@ LaserParticleContainer::Evolve (ablastr::fields::MultiFabRegister& fields,
                                   amplitude_E.dataPtr(), dt, push_type );
             WARPX_PROFILE_VAR_STOP(blp_pp);
 
+            cost_timer.record(KernelCost::GatherPush);
+
             // Current Deposition
             using ablastr::fields::Direction;
             if (!skip_deposition)
@@ -703,11 +706,7 @@ LaserParticleContainer::Evolve (ablastr::fields::MultiFabRegister& fields,
             // This is necessary because of plane_Xp, plane_Yp and amplitude_E
             amrex::Gpu::synchronize();
 
-            if (cost && WarpX::load_balance_costs_update_algo == LoadBalanceCostsUpdateAlgo::Timers)
-            {
-                wt = static_cast<Real>(amrex::second()) - wt;
-                amrex::HostDevice::Atomic::Add( &(*cost)[pti.index()], wt);
-            }
+            cost_timer.record(KernelCost::Deposition);
         }
     }
 }
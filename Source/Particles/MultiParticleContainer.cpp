@@ -12,6 +12,7 @@
 #include "MultiParticleContainer.H"
 
 #include "Fields.H"
+#include "Parallelization/CostTimer.H"
 #include "Particles/ElementaryProcess/Ionization.H"
 #ifdef WARPX_QED
 #   include "Particles/ElementaryProcess/QEDInternals/BreitWheelerEngineWrapper.H"
@@ -62,7 +63,9 @@
 #include <AMReX_MultiFab.H>
 #include <AMReX_PODVector.H>
 #include <AMReX_ParIter.H>
+#include <AMReX_ParallelContext.H>
 #include <AMReX_ParallelDescriptor.H>
+#include <AMReX_ParallelReduce.H>
 #include <AMReX_ParmParse.H>
 #include <AMReX_ParticleTile.H>
 #include <AMReX_Particles.H>
@@ -324,6 +327,7 @@ MultiParticleContainer::ReadParameters ()
 
         }
         pp_particles.query("use_fdtd_nci_corr", WarpX::use_fdtd_nci_corr);
+        pp_particles.query("do_neighbor_redistribute", m_do_neighbor_redistribute);
 #ifdef WARPX_DIM_RZ
         WARPX_ALWAYS_ASSERT_WITH_MESSAGE(WarpX::use_fdtd_nci_corr==0,
                             "ERROR: use_fdtd_nci_corr is not supported in RZ");
@@ -461,9 +465,10 @@ MultiParticleContainer::Evolve (ablastr::fields::MultiFabRegister& fields,
                                 int lev,
                                 std::string const& current_fp_string,
                                 Real t, Real dt, DtType a_dt_type, bool skip_deposition,
-                                PushType push_type)
+                                PushType push_type, PushRegion push_region)
 {
-    if (! skip_deposition) {
+    // When the push is split by region, the boundary particles deposit on top of the interior ones
+    if (! skip_deposition && push_region != PushRegion::Boundary) {
         using ablastr::fields::Direction;
 
         fields.get(current_fp_string, Direction{0}, lev)->setVal(0.0);
@@ -476,7 +481,7 @@ MultiParticleContainer::Evolve (ablastr::fields::MultiFabRegister& fields,
         if (fields.has(FieldType::rho_buf, lev)) { fields.get(FieldType::rho_buf, lev)->setVal(0.0); }
     }
     for (auto& pc : allcontainers) {
-        pc->Evolve(fields, lev, current_fp_string, t, dt, a_dt_type, skip_deposition, push_type);
+        pc->Evolve(fields, lev, current_fp_string, t, dt, a_dt_type, skip_deposition, push_type, push_region);
     }
 }
 
@@ -616,6 +621,10 @@ MultiParticleContainer::SortParticlesByBin (amrex::IntVect bin_size)
     for (auto& pc : allcontainers) {
         if (WarpX::sort_particles_for_deposition) {
             pc->SortParticlesForDeposition(WarpX::sort_idx_type);
+        } else if (WarpX::sort_disorder_threshold >= 0) {
+            pc->SortDisorderedTilesByBin(bin_size, WarpX::sort_disorder_threshold);
+        } else if (pc->HasValidCellIndex(0)) {
+            pc->SortParticlesByCellIndex(bin_size);
         } else {
             pc->SortParticlesByBin(bin_size);
         }
@@ -627,6 +636,7 @@ MultiParticleContainer::Redistribute ()
 {
     for (auto& pc : allcontainers) {
         pc->Redistribute();
+        pc->MarkCellIndexRedistributed();
     }
 }
 
@@ -651,6 +661,41 @@ MultiParticleContainer::RedistributeLocal (const int num_ghost)
 {
     for (auto& pc : allcontainers) {
         pc->Redistribute(0, 0, 0, num_ghost);
+        pc->MarkCellIndexRedistributed();
+    }
+}
+
+void
+MultiParticleContainer::RedistributeNeighbor (const int num_ghost)
+{
+    WARPX_PROFILE("MultiParticleContainer::RedistributeNeighbor()");
+
+    if (allcontainers.empty()) { return; }
+    if (allcontainers[0]->finestLevel() > 0) {
+        Redistribute();
+        return;
+    }
+
+    // All the species share the same layout, and thus the same plan
+    if (!m_neighbor_redistribute_plan) {
+        m_neighbor_redistribute_plan = std::make_unique<NeighborRedistributePlan>();
+    }
+    if (!m_neighbor_redistribute_plan->isDefinedFor(*allcontainers[0], num_ghost)) {
+        m_neighbor_redistribute_plan->define(*allcontainers[0], num_ghost);
+    }
+
+    const auto nspecies = static_cast<int>(allcontainers.size());
+    Vector<Long> num_out_of_reach(nspecies);
+    for (int i = 0; i < nspecies; ++i) {
+        num_out_of_reach[i] = m_neighbor_redistribute_plan->Redistribute(*allcontainers[i]);
+    }
+    ParallelAllReduce::Max(num_out_of_reach.data(), nspecies,
+                           ParallelContext::CommunicatorSub());
+
+    for (int i = 0; i < nspecies; ++i) {
+        // Some particles moved further than the neighbor boxes
+        if (num_out_of_reach[i] > 0) { allcontainers[i]->Redistribute(); }
+        allcontainers[i]->MarkCellIndexRedistributed();
     }
 }
 
@@ -718,6 +763,14 @@ MultiParticleContainer::SetParticleDistributionMap (int lev, DistributionMapping
     }
 }
 
+void
+MultiParticleContainer::SetParticleGeometry (int lev, Geometry& new_geom)
+{
+    for (auto& pc : allcontainers) {
+        pc->SetParticleGeometry(lev,new_geom);
+    }
+}
+
 /* \brief Continuous injection for particles initially outside of the domain.
  * \param injection_box: Domain where new particles should be injected.
  * Loop over all WarpXParticleContainer in MultiParticleContainer and
@@ -875,8 +928,6 @@ MultiParticleContainer::doFieldIonization (int lev,
 {
     WARPX_PROFILE("MultiParticleContainer::doFieldIonization()");
 
-    amrex::LayoutData<amrex::Real>* cost = WarpX::getCosts(lev);
-
     // Loop over all species.
     // Ionized particles in pc_source create particles in pc_product
     for (auto& pc_source : allcontainers)
@@ -893,6 +944,7 @@ MultiParticleContainer::doFieldIonization (int lev,
 
         pc_source ->defineAllParticleTiles();
         pc_product->defineAllParticleTiles();
+        pc_product->InvalidateCellIndex();
 
         auto info = getMFItInfo(*pc_source, *pc_product);
 
@@ -901,11 +953,7 @@ MultiParticleContainer::doFieldIonization (int lev,
 #endif
         for (WarpXParIter pti(*pc_source, lev, info); pti.isValid(); ++pti)
         {
-            if (cost && WarpX::load_balance_costs_update_algo == LoadBalanceCostsUpdateAlgo::Timers)
-            {
-                amrex::Gpu::synchronize();
-            }
-            auto wt = static_cast<amrex::Real>(amrex::second());
+            CostTimer cost_timer(lev, pti.index());
 
             auto& src_tile = pc_source ->ParticlesAt(lev, pti);
             auto& dst_tile = pc_product->ParticlesAt(lev, pti);
@@ -920,12 +968,7 @@ MultiParticleContainer::doFieldIonization (int lev,
 
             setNewParticleIDs(dst_tile, np_dst, num_added);
 
-            if (cost && WarpX::load_balance_costs_update_algo == LoadBalanceCostsUpdateAlgo::Timers)
-            {
-                amrex::Gpu::synchronize();
-                wt = static_cast<amrex::Real>(amrex::second()) - wt;
-                amrex::HostDevice::Atomic::Add( &(*cost)[pti.index()], wt);
-            }
+            cost_timer.record(KernelCost::ParticleCreation);
         }
     }
 }
@@ -1354,6 +1397,8 @@ MultiParticleContainer::doQEDSchwinger ()
 
     pc_product_ele->defineAllParticleTiles();
     pc_product_pos->defineAllParticleTiles();
+    pc_product_ele->InvalidateCellIndex();
+    pc_product_pos->InvalidateCellIndex();
 
     using ablastr::fields::Direction;
     const MultiFab & Ex = *warpx.m_fields.get(FieldType::Efield_aux, Direction{0}, level_0);
@@ -1500,8 +1545,6 @@ void MultiParticleContainer::doQedBreitWheeler (int lev,
 {
     WARPX_PROFILE("MultiParticleContainer::doQedBreitWheeler()");
 
-    amrex::LayoutData<amrex::Real>* cost = WarpX::getCosts(lev);
-
     // Loop over all species.
     // Photons undergoing Breit Wheeler process create electrons
     // in pc_product_ele and positrons in pc_product_pos
@@ -1528,6 +1571,8 @@ void MultiParticleContainer::doQedBreitWheeler (int lev,
         pc_source ->defineAllParticleTiles();
         pc_product_pos->defineAllParticleTiles();
         pc_product_ele->defineAllParticleTiles();
+        pc_product_pos->InvalidateCellIndex();
+        pc_product_ele->InvalidateCellIndex();
 
         auto info = getMFItInfo(*pc_source, *pc_product_ele, *pc_product_pos);
 
@@ -1536,11 +1581,7 @@ void MultiParticleContainer::doQedBreitWheeler (int lev,
 #endif
         for (WarpXParIter pti(*pc_source, lev, info); pti.isValid(); ++pti)
         {
-            if (cost && WarpX::load_balance_costs_update_algo == LoadBalanceCostsUpdateAlgo::Timers)
-            {
-                amrex::Gpu::synchronize();
-            }
-            auto wt = static_cast<amrex::Real>(amrex::second());
+            CostTimer cost_timer(lev, pti.index());
 
             auto Transform = PairGenerationTransformFunc(pair_gen_functor,
                                                          pti, lev, Ex.nGrowVect(),
@@ -1563,12 +1604,7 @@ void MultiParticleContainer::doQedBreitWheeler (int lev,
             setNewParticleIDs(dst_ele_tile, np_dst_ele, num_added);
             setNewParticleIDs(dst_pos_tile, np_dst_pos, num_added);
 
-            if (cost && WarpX::load_balance_costs_update_algo == LoadBalanceCostsUpdateAlgo::Timers)
-            {
-                amrex::Gpu::synchronize();
-                wt = static_cast<amrex::Real>(amrex::second()) - wt;
-                amrex::HostDevice::Atomic::Add( &(*cost)[pti.index()], wt);
-            }
+            cost_timer.record(KernelCost::ParticleCreation);
         }
     }
 }
@@ -1583,8 +1619,6 @@ void MultiParticleContainer::doQedQuantumSync (int lev,
 {
     WARPX_PROFILE("MultiParticleContainer::doQedQuantumSync()");
 
-    amrex::LayoutData<amrex::Real>* cost = WarpX::getCosts(lev);
-
     // Loop over all species.
     // Electrons or positrons undergoing Quantum photon emission process
     // create photons in pc_product_phot
@@ -1605,6 +1639,7 @@ void MultiParticleContainer::doQedQuantumSync (int lev,
 
         pc_source ->defineAllParticleTiles();
         pc_product_phot->defineAllParticleTiles();
+        pc_product_phot->InvalidateCellIndex();
 
         auto info = getMFItInfo(*pc_source, *pc_product_phot);
 
@@ -1613,11 +1648,7 @@ void MultiParticleContainer::doQedQuantumSync (int lev,
 #endif
         for (WarpXParIter pti(*pc_source, lev, info); pti.isValid(); ++pti)
         {
-            if (cost && WarpX::load_balance_costs_update_algo == LoadBalanceCostsUpdateAlgo::Timers)
-            {
-                amrex::Gpu::synchronize();
-            }
-            auto wt = static_cast<amrex::Real>(amrex::second());
+            CostTimer cost_timer(lev, pti.index());
 
             auto Transform = PhotonEmissionTransformFunc(
                   m_shr_p_qs_engine->build_optical_depth_functor(),
@@ -1644,12 +1675,7 @@ void MultiParticleContainer::doQedQuantumSync (int lev,
                                   dst_tile, np_dst, num_added,
                                   m_quantum_sync_photon_creation_energy_threshold);
 
-            if (cost && WarpX::load_balance_costs_update_algo == LoadBalanceCostsUpdateAlgo::Timers)
-            {
-                amrex::Gpu::synchronize();
-                wt = static_cast<amrex::Real>(amrex::second()) - wt;
-                amrex::HostDevice::Atomic::Add( &(*cost)[pti.index()], wt);
-            }
+            cost_timer.record(KernelCost::ParticleCreation);
         }
     }
 }
@@ -0,0 +1,482 @@
+/* Copyright 2025 The WarpX Community
+ *
+ * This file is part of WarpX.
+ *
+ * License: BSD-3-Clause-LBNL
+ */
+#include "NeighborRedistribute.H"
+
+#include "Particles/WarpXParticleContainer.H"
+#include "Utils/TextMsg.H"
+#include "Utils/WarpXProfilerWrapper.H"
+
+#include <AMReX_Geometry.H>
+#include <AMReX_GpuContainers.H>
+#include <AMReX_GpuDevice.H>
+#include <AMReX_GpuLaunch.H>
+#include <AMReX_ParallelContext.H>
+#include <AMReX_ParallelDescriptor.H>
+#include <AMReX_ParticleTransformation.H>
+#include <AMReX_ParticleUtil.H>
+#include <AMReX_Periodicity.H>
+#include <AMReX_Reduce.H>
+#include <AMReX_Scan.H>
+
+#include <algorithm>
+#include <climits>
+#include <cstdint>
+#include <cstring>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+using namespace amrex;
+
+namespace
+{
+    // Destination of a particle, when it is not the index of a neighbor box
+    constexpr int stays_in_tile = -1;
+    constexpr int out_of_reach = -2;
+    constexpr int other_tile_of_box = -3;
+
+    /** Number of bytes of a particle in the send and receive buffers:
+     *  id/cpu, real and int components, and index of the destination box and tile */
+    int record_size (int nreal, int nint)
+    {
+        const auto bytes = sizeof(std::uint64_t) + nreal*sizeof(ParticleReal)
+            + (nint + 2)*sizeof(int);
+        constexpr auto align = sizeof(std::uint64_t);
+        return static_cast<int>((bytes + align - 1)/align*align);
+    }
+}
+
+NeighborRedistributePlan::~NeighborRedistributePlan ()
+{
+    clear();
+}
+
+bool
+NeighborRedistributePlan::isDefinedFor (WarpXParticleContainer const& pc, int num_ghost) const
+{
+    return m_num_ghost == num_ghost
+        && m_domain == pc.Geom(0).Domain()
+        && m_ba == pc.ParticleBoxArray(0)
+        && m_dm == pc.ParticleDistributionMap(0);
+}
+
+void
+NeighborRedistributePlan::clear ()
+{
+#ifdef AMREX_USE_MPI
+    if (m_comm != MPI_COMM_NULL) {
+        int finalized = 0;
+        MPI_Finalized(&finalized);
+        if (!finalized) { MPI_Comm_free(&m_comm); }
+        m_comm = MPI_COMM_NULL;
+    }
+#endif
+    m_num_ghost = -1;
+    m_local_index.clear();
+    m_nbr_offset.clear();
+    m_nbr_image.clear();
+    m_nbr_shift.clear();
+    m_nbr_grid.clear();
+    m_nbr_slot.clear();
+    m_nbr_ranks.clear();
+}
+
+void
+NeighborRedistributePlan::define (WarpXParticleContainer const& pc, int num_ghost)
+{
+    WARPX_PROFILE("NeighborRedistributePlan::define()");
+
+    clear();
+
+    const int lev = 0;
+    m_ba = pc.ParticleBoxArray(lev);
+    m_dm = pc.ParticleDistributionMap(lev);
+    m_domain = pc.Geom(lev).Domain();
+    m_num_ghost = num_ghost;
+
+    const int myproc = ParallelContext::MyProcSub();
+    const std::vector<IntVect> shifts = pc.Geom(lev).periodicity().shiftIntVect();
+
+    // Boxes in the reach of each local box, including periodic images
+    Vector<int> offset(1, 0);
+    Vector<Box> image;
+    Vector<IntVect> shift;
+    Vector<int> grid;
+    Vector<int> owner;
+    m_local_index.assign(m_ba.size(), -1);
+    int num_local = 0;
+    for (int gid = 0; gid < static_cast<int>(m_ba.size()); ++gid) {
+        if (m_dm[gid] != myproc) { continue; }
+        m_local_index[gid] = num_local++;
+        const Box grown_box = amrex::grow(m_ba[gid], num_ghost);
+        for (auto const& s : shifts) {
+            for (auto const& isect : m_ba.intersections(grown_box + s)) {
+                const int j = isect.first;
+                if (j == gid && s == IntVect::TheZeroVector()) { continue; }
+                image.push_back(m_ba[j] - s);
+                shift.push_back(s);
+                grid.push_back(j);
+                owner.push_back(m_dm[j]);
+            }
+        }
+        offset.push_back(static_cast<int>(image.size()));
+    }
+
+    // The neighbor relation is symmetric, so that each rank sends to and
+    // receives from the same ranks
+    for (auto const rank : owner) {
+        if (rank != myproc) { m_nbr_ranks.push_back(rank); }
+    }
+    std::sort(m_nbr_ranks.begin(), m_nbr_ranks.end());
+    m_nbr_ranks.erase(std::unique(m_nbr_ranks.begin(), m_nbr_ranks.end()), m_nbr_ranks.end());
+
+    Vector<int> slot(owner.size());
+    for (int k = 0; k < static_cast<int>(owner.size()); ++k) {
+        slot[k] = (owner[k] == myproc) ? -1 : static_cast<int>(
+            std::lower_bound(m_nbr_ranks.begin(), m_nbr_ranks.end(), owner[k]) - m_nbr_ranks.begin());
+    }
+
+    m_nbr_offset.resize(offset.size());
+    m_nbr_image.resize(image.size());
+    m_nbr_shift.resize(shift.size());
+    m_nbr_grid.resize(grid.size());
+    m_nbr_slot.resize(slot.size());
+    Gpu::copyAsync(Gpu::hostToDevice, offset.begin(), offset.end(), m_nbr_offset.begin());
+    Gpu::copyAsync(Gpu::hostToDevice, image.begin(), image.end(), m_nbr_image.begin());
+    Gpu::copyAsync(Gpu::hostToDevice, shift.begin(), shift.end(), m_nbr_shift.begin());
+    Gpu::copyAsync(Gpu::hostToDevice, grid.begin(), grid.end(), m_nbr_grid.begin());
+    Gpu::copyAsync(Gpu::hostToDevice, slot.begin(), slot.end(), m_nbr_slot.begin());
+    Gpu::streamSynchronize();
+
+    const auto nnbr = static_cast<int>(m_nbr_ranks.size());
+    m_send_counts.resize(nnbr);
+    m_recv_counts.resize(nnbr);
+    m_send_displs.resize(nnbr);
+    m_recv_displs.resize(nnbr);
+
+#ifdef AMREX_USE_MPI
+    MPI_Dist_graph_create_adjacent(ParallelContext::CommunicatorSub(),
+                                   nnbr, m_nbr_ranks.data(), MPI_UNWEIGHTED,
+                                   nnbr, m_nbr_ranks.data(), MPI_UNWEIGHTED,
+                                   MPI_INFO_NULL, 0, &m_comm);
+#endif
+}
+
+Long
+NeighborRedistributePlan::Redistribute (WarpXParticleContainer& pc)
+{
+    WARPX_PROFILE("NeighborRedistributePlan::Redistribute()");
+
+    using ParticleTileType = WarpXParticleContainer::ParticleTileType;
+
+    const int lev = 0;
+    const Geometry& geom = pc.Geom(lev);
+    const auto plo = geom.ProbLoArray();
+    const auto dxi = geom.InvCellSizeArray();
+    const auto plen = geom.ProbLengthArray();
+    const Box domain = m_domain;
+    const bool do_tiling = WarpXParticleContainer::do_tiling;
+    const IntVect tile_size = WarpXParticleContainer::tile_size;
+
+    const int* const nbr_offset = m_nbr_offset.dataPtr();
+    const Box* const nbr_image = m_nbr_image.dataPtr();
+    const IntVect* const nbr_shift = m_nbr_shift.dataPtr();
+    const int* const nbr_grid = m_nbr_grid.dataPtr();
+    const int* const nbr_slot = m_nbr_slot.dataPtr();
+
+    // Copy the particles that leave their tile to `movers`, and remove them from their tile
+    ParticleTileType movers;
+    movers.define(pc.NumRuntimeRealComps(), pc.NumRuntimeIntComps());
+    Gpu::DeviceVector<int> mover_grid;
+    Gpu::DeviceVector<int> mover_tile;
+    Gpu::DeviceVector<int> mover_slot;
+    Gpu::DeviceVector<int> dst;
+    Gpu::DeviceVector<int> dst_tile;
+    Gpu::DeviceVector<int> flag;
+    Gpu::DeviceVector<int> pos;
+    Long num_out_of_reach = 0;
+
+    for (auto& [index, ptile] : pc.GetParticles(lev)) {
+        const int np = static_cast<int>(ptile.numParticles());
+        if (np == 0) { continue; }
+
+        const int gid = index.first;
+        const int tid = index.second;
+        const int li = m_local_index[gid];
+        const Box box = m_ba[gid];
+
+        dst.resize(np);
+        dst_tile.resize(np);
+        flag.resize(np);
+        pos.resize(np);
+        int* const pdst = dst.dataPtr();
+        int* const pdst_tile = dst_tile.dataPtr();
+        int* const pflag = flag.dataPtr();
+        int* const ppos = pos.dataPtr();
+
+        const auto ptd = ptile.getParticleTileData();
+        ParallelFor(np, [=] AMREX_GPU_DEVICE (int i) noexcept
+        {
+            int d = stays_in_tile;
+            int t = tid;
+            if (ParticleIDWrapper{ptd.m_idcpu[i]}.is_valid()) {
+                const IntVect iv = getParticleCell(ptd, i, plo, dxi, domain);
+                Box tbx;
+                if (box.contains(iv)) {
+                    t = getTileIndex(iv, box, do_tiling, tile_size, tbx);
+                    if (t != tid) { d = other_tile_of_box; }
+                } else {
+                    d = out_of_reach;
+                    for (int k = nbr_offset[li]; k < nbr_offset[li+1]; ++k) {
+                        if (nbr_image[k].contains(iv)) {
+                            d = k;
+                            t = getTileIndex(iv + nbr_shift[k], nbr_image[k] + nbr_shift[k],
+                                             do_tiling, tile_size, tbx);
+                            break;
+                        }
+                    }
+                }
+            }
+            pdst[i] = d;
+            pdst_tile[i] = t;
+            pflag[i] = (d >= 0 || d == other_tile_of_box) ? 1 : 0;
+        });
+
+        num_out_of_reach += Reduce::Sum<Long>(np,
+            [=] AMREX_GPU_DEVICE (int i) noexcept -> Long
+            {
+                return (pdst[i] == out_of_reach) ? 1 : 0;
+            });
+
+        const int num_movers = Scan::ExclusiveSum(np, pflag, ppos);
+        if (num_movers > 0) {
+            const int old_size = static_cast<int>(movers.numParticles());
+            const int new_size = old_size + num_movers;
+            movers.resize(new_size);
+            mover_grid.resize(new_size);
+            mover_tile.resize(new_size);
+            mover_slot.resize(new_size);
+            int* const pgrid = mover_grid.dataPtr();
+            int* const ptile_index = mover_tile.dataPtr();
+            int* const pslot = mover_slot.dataPtr();
+
+            const auto src = ptile.getConstParticleTileData();
+            const auto dst_ptd = movers.getParticleTileData();
+            ParallelFor(np, [=] AMREX_GPU_DEVICE (int i) noexcept
+            {
+                if (!pflag[i]) { return; }
+                const int j = old_size + ppos[i];
+                copyParticle(dst_ptd, src, i, j);
+                const int d = pdst[i];
+                if (d == other_tile_of_box) {
+                    pgrid[j] = gid;
+                    pslot[j] = -1;
+                } else {
+                    pgrid[j] = nbr_grid[d];
+                    pslot[j] = nbr_slot[d];
+                    // Same shift of the position as in amrex::enforcePeriodic
+                    for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+                        if (nbr_shift[d][idim] > 0) { dst_ptd.rdata(idim)[j] += plen[idim]; }
+                        if (nbr_shift[d][idim] < 0) { dst_ptd.rdata(idim)[j] -= plen[idim]; }
+                    }
+                }
+                ptile_index[j] = pdst_tile[i];
+                ParticleIDWrapper{ptd.m_idcpu[i]}.make_invalid();
+            });
+        }
+
+        removeInvalidParticles(ptile);
+        Gpu::streamSynchronize();
+    }
+
+    // Order the movers by destination rank, with the ones that stay on this rank last
+    const auto nnbr = static_cast<int>(m_nbr_ranks.size());
+    const int num_movers = static_cast<int>(movers.numParticles());
+    Vector<int> h_slot(num_movers);
+    Gpu::copyAsync(Gpu::deviceToHost, mover_slot.begin(), mover_slot.end(), h_slot.begin());
+    Gpu::streamSynchronize();
+
+    Vector<int> count(nnbr + 1, 0);
+    for (auto& s : h_slot) {
+        if (s < 0) { s = nnbr; }
+        ++count[s];
+    }
+    Vector<int> start(nnbr + 1, 0);
+    std::exclusive_scan(count.begin(), count.end(), start.begin(), 0);
+    Vector<int> h_order(num_movers);
+    {
+        Vector<int> next = start;
+        for (int j = 0; j < num_movers; ++j) { h_order[next[h_slot[j]]++] = j; }
+    }
+    Gpu::DeviceVector<int> order(num_movers);
+    Gpu::copyAsync(Gpu::hostToDevice, h_order.begin(), h_order.end(), order.begin());
+
+    // Pack the movers in the persistent send buffer
+    const int nreal = pc.NumRealComps();
+    const int nint = pc.NumIntComps();
+    const int rsize = record_size(nreal, nint);
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+        static_cast<Long>(num_movers)*rsize < static_cast<Long>(INT_MAX),
+        "Too many particles moved by the neighbor redistribution");
+    m_send_buffer.resize(static_cast<std::size_t>(num_movers)*rsize);
+    char* const send = m_send_buffer.dataPtr();
+    const int* const porder = order.dataPtr();
+    const int* const pgrid = mover_grid.dataPtr();
+    const int* const ptile_index = mover_tile.dataPtr();
+    const auto movers_ptd = movers.getConstParticleTileData();
+    ParallelFor(num_movers, [=] AMREX_GPU_DEVICE (int q) noexcept
+    {
+        const int j = porder[q];
+        char* rec = send + static_cast<std::size_t>(q)*rsize;
+        std::memcpy(rec, movers_ptd.m_idcpu + j, sizeof(std::uint64_t));
+        rec += sizeof(std::uint64_t);
+        for (int c = 0; c < nreal; ++c) {
+            std::memcpy(rec, movers_ptd.rdata(c) + j, sizeof(ParticleReal));
+            rec += sizeof(ParticleReal);
+        }
+        for (int c = 0; c < nint; ++c) {
+            std::memcpy(rec, movers_ptd.idata(c) + j, sizeof(int));
+            rec += sizeof(int);
+        }
+        std::memcpy(rec, pgrid + j, sizeof(int));
+        rec += sizeof(int);
+        std::memcpy(rec, ptile_index + j, sizeof(int));
+    });
+    Gpu::streamSynchronize();
+
+    // Exchange the movers with the neighbor ranks
+    int num_recv = 0;
+#ifdef AMREX_USE_MPI
+    for (int s = 0; s < nnbr; ++s) { m_send_counts[s] = count[s]; }
+    MPI_Neighbor_alltoall(m_send_counts.data(), 1, MPI_INT,
+                          m_recv_counts.data(), 1, MPI_INT, m_comm);
+    for (int s = 0; s < nnbr; ++s) {
+        m_send_displs[s] = start[s]*rsize;
+        m_send_counts[s] *= rsize;
+        m_recv_displs[s] = num_recv*rsize;
+        num_recv += m_recv_counts[s];
+        m_recv_counts[s] *= rsize;
+    }
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+        static_cast<Long>(num_recv)*rsize < static_cast<Long>(INT_MAX),
+        "Too many particles received by the neighbor redistribution");
+    m_recv_buffer.resize(static_cast<std::size_t>(num_recv)*rsize);
+
+    const std::size_t send_bytes = static_cast<std::size_t>(start[nnbr])*rsize;
+    const std::size_t recv_bytes = static_cast<std::size_t>(num_recv)*rsize;
+    char* send_ptr = m_send_buffer.dataPtr();
+    char* recv_ptr = m_recv_buffer.dataPtr();
+#ifdef AMREX_USE_GPU
+    if (!ParallelDescriptor::UseGpuAwareMpi()) {
+        m_send_host.resize(send_bytes);
+        m_recv_host.resize(recv_bytes);
+        Gpu::dtoh_memcpy_async(m_send_host.dataPtr(), send_ptr, send_bytes);
+        Gpu::streamSynchronize();
+        send_ptr = m_send_host.dataPtr();
+        recv_ptr = m_recv_host.dataPtr();
+    }
+#endif
+    MPI_Neighbor_alltoallv(send_ptr, m_send_counts.data(), m_send_displs.data(), MPI_CHAR,
+                           recv_ptr, m_recv_counts.data(), m_recv_displs.data(), MPI_CHAR,
+                           m_comm);
+#ifdef AMREX_USE_GPU
+    if (!ParallelDescriptor::UseGpuAwareMpi()) {
+        Gpu::htod_memcpy_async(m_recv_buffer.dataPtr(), recv_ptr, recv_bytes);
+        Gpu::streamSynchronize();
+    }
+#endif
+    amrex::ignore_unused(send_bytes, recv_bytes);
+#endif
+
+    // Add the received particles and the ones that stay on this rank to their tile
+    Unpack(pc, m_recv_buffer.dataPtr(), num_recv, rsize);
+    Unpack(pc, m_send_buffer.dataPtr() + static_cast<std::size_t>(start[nnbr])*rsize,
+           count[nnbr], rsize);
+
+    return num_out_of_reach;
+}
+
+void
+NeighborRedistributePlan::Unpack (WarpXParticleContainer& pc, char const* buffer,
+                                  int n, int rsize) const
+{
+    if (n == 0) { return; }
+
+    using ParticleTileType = WarpXParticleContainer::ParticleTileType;
+
+    const int nreal = pc.NumRealComps();
+    const int nint = pc.NumIntComps();
+    const auto key_offset = static_cast<std::size_t>(
+        sizeof(std::uint64_t) + nreal*sizeof(ParticleReal) + nint*sizeof(int));
+
+    // Destination box and tile of each particle
+    Gpu::DeviceVector<int> grid(n);
+    Gpu::DeviceVector<int> tile(n);
+    int* const pgrid = grid.dataPtr();
+    int* const ptile_index = tile.dataPtr();
+    ParallelFor(n, [=] AMREX_GPU_DEVICE (int q) noexcept
+    {
+        char const* rec = buffer + static_cast<std::size_t>(q)*rsize + key_offset;
+        std::memcpy(pgrid + q, rec, sizeof(int));
+        std::memcpy(ptile_index + q, rec + sizeof(int), sizeof(int));
+    });
+    Vector<int> h_grid(n);
+    Vector<int> h_tile(n);
+    Gpu::copyAsync(Gpu::deviceToHost, grid.begin(), grid.end(), h_grid.begin());
+    Gpu::copyAsync(Gpu::deviceToHost, tile.begin(), tile.end(), h_tile.begin());
+    Gpu::streamSynchronize();
+
+    // Position of each particle once ordered by destination
+    Vector<int> h_order(n);
+    std::iota(h_order.begin(), h_order.end(), 0);
+    std::stable_sort(h_order.begin(), h_order.end(), [&] (int a, int b) {
+        return std::make_pair(h_grid[a], h_tile[a]) < std::make_pair(h_grid[b], h_tile[b]);
+    });
+    Vector<int> h_position(n);
+    for (int q = 0; q < n; ++q) { h_position[h_order[q]] = q; }
+    Gpu::DeviceVector<int> position(n);
+    Gpu::copyAsync(Gpu::hostToDevice, h_position.begin(), h_position.end(), position.begin());
+    const int* const pposition = position.dataPtr();
+
+    ParticleTileType incoming;
+    incoming.define(pc.NumRuntimeRealComps(), pc.NumRuntimeIntComps());
+    incoming.resize(n);
+    const auto ptd = incoming.getParticleTileData();
+    ParallelFor(n, [=] AMREX_GPU_DEVICE (int q) noexcept
+    {
+        const int j = pposition[q];
+        char const* rec = buffer + static_cast<std::size_t>(q)*rsize;
+        std::memcpy(ptd.m_idcpu + j, rec, sizeof(std::uint64_t));
+        rec += sizeof(std::uint64_t);
+        for (int c = 0; c < nreal; ++c) {
+            std::memcpy(ptd.rdata(c) + j, rec, sizeof(ParticleReal));
+            rec += sizeof(ParticleReal);
+        }
+        for (int c = 0; c < nint; ++c) {
+            std::memcpy(ptd.idata(c) + j, rec, sizeof(int));
+            rec += sizeof(int);
+        }
+    });
+
+    // Append each run of particles with the same destination to its tile
+    int begin = 0;
+    while (begin < n) {
+        const int g = h_grid[h_order[begin]];
+        const int t = h_tile[h_order[begin]];
+        int end = begin + 1;
+        while (end < n && h_grid[h_order[end]] == g && h_tile[h_order[end]] == t) { ++end; }
+        auto& ptile = pc.DefineAndReturnParticleTile(0, g, t);
+        const int old_size = static_cast<int>(ptile.numParticles());
+        ptile.resize(old_size + end - begin);
+        copyParticles(ptile, incoming, begin, old_size, end - begin);
+        begin = end;
+    }
+
+    // Make sure that the temporary arrays are not destroyed before
+    // the GPU kernels finish running
+    Gpu::streamSynchronize();
+}
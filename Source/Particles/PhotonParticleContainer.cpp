@@ -45,8 +45,15 @@ using namespace amrex;
 
 PhotonParticleContainer::PhotonParticleContainer (AmrCore* amr_core, int ispecies,
                                                   const std::string& name)
-    : PhysicalParticleContainer(amr_core, ispecies, name)
+    : PhysicalParticleContainer(amr_core, ispecies, name, false)
 {
+    // Photons have their own PushPX, which does not implement the fused
+    // push-deposit kernel, the update of the cached cell index (so the
+    // cell index is not cached, see above) nor the storage of the gather
+    // shape factors
+    m_fuse_push_and_deposit = false;
+    m_reuse_gather_shape_factors = false;
+
     const ParmParse pp_species_name(species_name);
 
 #ifdef WARPX_QED
@@ -91,7 +98,8 @@ PhotonParticleContainer::PushPX (WarpXParIter& pti,
                                  const long offset,
                                  const long np_to_push,
                                  int lev, int gather_lev,
-                                 amrex::Real dt, ScaleFields /*scaleFields*/, DtType a_dt_type)
+                                 amrex::Real dt, ScaleFields /*scaleFields*/, DtType a_dt_type,
+                                 NodeShapeFactorsArray const& /*gather_shapes*/)
 {
     // Get inverse cell size on gather_lev
     const amrex::XDim3 dinv = WarpX::InvCellSize(std::max(gather_lev,0));
@@ -233,13 +241,13 @@ PhotonParticleContainer::Evolve (ablastr::fields::MultiFabRegister& fields,
                                  int lev,
                                  const std::string& current_fp_string,
                                  Real t, Real dt, DtType a_dt_type, bool skip_deposition,
-                                 PushType push_type)
+                                 PushType push_type, PushRegion push_region)
 {
     // This does gather, push and deposit.
     // Push and deposit have been re-written for photons
     PhysicalParticleContainer::Evolve (fields,
                                        lev,
                                        current_fp_string,
-                                       t, dt, a_dt_type, skip_deposition, push_type);
+                                       t, dt, a_dt_type, skip_deposition, push_type, push_region);
 
 }
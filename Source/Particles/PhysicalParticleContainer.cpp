@@ -16,7 +16,10 @@
 #include "Initialization/InjectorMomentum.H"
 #include "Initialization/InjectorPosition.H"
 #include "MultiParticleContainer.H"
+#include "Parallelization/CostTimer.H"
 #include "Particles/AddPlasmaUtilities.H"
+#include "Particles/Deposition/ChargeDeposition.H"
+#include "Particles/Deposition/CurrentDeposition.H"
 #ifdef WARPX_QED
 #   include "Particles/ElementaryProcess/QEDInternals/BreitWheelerEngineWrapper.H"
 #   include "Particles/ElementaryProcess/QEDInternals/QuantumSyncEngineWrapper.H"
@@ -26,12 +29,14 @@
 #include "Particles/ParticleCreation/DefaultInitialization.H"
 #include "Particles/Pusher/CopyParticleAttribs.H"
 #include "Particles/Pusher/GetAndSetPosition.H"
+#include "Particles/Pusher/PushPXKernel.H"
 #include "Particles/Pusher/PushSelector.H"
 #include "Particles/Pusher/UpdateMomentumBoris.H"
 #include "Particles/Pusher/UpdateMomentumBorisWithRadiationReaction.H"
 #include "Particles/Pusher/UpdateMomentumHigueraCary.H"
 #include "Particles/Pusher/UpdateMomentumVay.H"
 #include "Particles/Pusher/UpdatePosition.H"
+#include "Particles/Sorting/CellIndex.H"
 #include "Particles/SpeciesPhysicalProperties.H"
 #include "Particles/WarpXParticleContainer.H"
 #include "Utils/Parser/ParserUtils.H"
@@ -216,10 +221,24 @@ namespace
     {
         return amrex::Math::powi<2>(x);
     }
+
+    /** Whether the particles move by less than one cell per time step along every
+     *  direction, as assumed by the Esirkepov deposition that reuses the shape
+     *  factors of the field gather at the old position
+     */
+    bool MovesLessThanOneCell (const amrex::Geometry& geom, const amrex::Real dt)
+    {
+        const auto dxi = geom.InvCellSizeArray();
+        for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+            if (PhysConst::c*dt*dxi[idim] >= 1._rt) { return false; }
+        }
+        return true;
+    }
 }
 
 PhysicalParticleContainer::PhysicalParticleContainer (AmrCore* amr_core, int ispecies,
-                                                      const std::string& name)
+                                                      const std::string& name,
+                                                      bool can_cache_cell_index)
     : WarpXParticleContainer(amr_core, ispecies),
       species_name(name)
 {
@@ -406,6 +425,17 @@ PhysicalParticleContainer::PhysicalParticleContainer (AmrCore* amr_core, int isp
 #endif
     }
 
+    m_fuse_push_and_deposit = WarpX::do_fused_push_deposit;
+    m_reuse_gather_shape_factors = WarpX::reuse_gather_shape_factors;
+
+    // If the cell index of the particles is cached, add the needed components
+    m_cache_cell_index = can_cache_cell_index && WarpX::cache_particle_cell_index;
+    if (m_cache_cell_index) {
+        for (const auto& name : CellIndexCompNames()) {
+            AddIntComp(name);
+        }
+    }
+
     // Read reflection models for absorbing boundaries; defaults to a zero
     pp_species_name.query("reflection_model_xlo(E)", m_boundary_conditions.reflection_model_xlo_str);
     pp_species_name.query("reflection_model_xhi(E)", m_boundary_conditions.reflection_model_xhi_str);
@@ -1106,6 +1136,9 @@ PhysicalParticleContainer::AddPlasma (PlasmaInjector const& plasma_injector, int
 {
     WARPX_PROFILE("PhysicalParticleContainer::AddPlasma()");
 
+    // The new particles do not have a cell index yet
+    InvalidateCellIndex();
+
     // If no part_realbox is provided, initialize particles in the whole domain
     const Geometry& geom = Geom(lev);
     if (!part_realbox.ok()) { part_realbox = geom.ProbDomain(); }
@@ -1120,8 +1153,6 @@ PhysicalParticleContainer::AddPlasma (PlasmaInjector const& plasma_injector, int
 
     defineAllParticleTiles();
 
-    amrex::LayoutData<amrex::Real>* cost = WarpX::getCosts(lev);
-
     Box fine_injection_box;
     amrex::IntVect rrfac(AMREX_D_DECL(1,1,1));
     const bool refine_injection = findRefinedInjectionBox(fine_injection_box, rrfac);
@@ -1157,11 +1188,7 @@ PhysicalParticleContainer::AddPlasma (PlasmaInjector const& plasma_injector, int
 #endif
     for (MFIter mfi = MakeMFIter(lev, info); mfi.isValid(); ++mfi)
     {
-        if (cost && WarpX::load_balance_costs_update_algo == LoadBalanceCostsUpdateAlgo::Timers)
-        {
-            amrex::Gpu::synchronize();
-        }
-        auto wt = static_cast<amrex::Real>(amrex::second());
+        CostTimer cost_timer(lev, mfi.index());
 
         const Box& tile_box = mfi.tilebox();
         const RealBox tile_realbox = WarpX::getRealBox(tile_box, lev);
@@ -1489,11 +1516,7 @@ PhysicalParticleContainer::AddPlasma (PlasmaInjector const& plasma_injector, int
 
         amrex::Gpu::synchronize();
 
-        if (cost && WarpX::load_balance_costs_update_algo == LoadBalanceCostsUpdateAlgo::Timers)
-        {
-            wt = static_cast<amrex::Real>(amrex::second()) - wt;
-            amrex::HostDevice::Atomic::Add( &(*cost)[mfi.index()], wt);
-        }
+        cost_timer.record(KernelCost::ParticleCreation);
     }
 
     // Remove particles that are inside the embedded boundaries
@@ -1517,6 +1540,9 @@ PhysicalParticleContainer::AddPlasmaFlux (PlasmaInjector const& plasma_injector,
 {
     WARPX_PROFILE("PhysicalParticleContainer::AddPlasmaFlux()");
 
+    // The new particles do not have a cell index yet
+    InvalidateCellIndex();
+
     const Geometry& geom = Geom(0);
     const amrex::RealBox& part_realbox = geom.ProbDomain();
 
@@ -1539,8 +1565,6 @@ PhysicalParticleContainer::AddPlasmaFlux (PlasmaInjector const& plasma_injector,
     }
 #endif
 
-    amrex::LayoutData<amrex::Real>* cost = WarpX::getCosts(0);
-
     // Create temporary particle container to which particles will be added;
     // we will then call Redistribute on this new container and finally
     // add the new particles to the original container.
@@ -1582,11 +1606,7 @@ PhysicalParticleContainer::AddPlasmaFlux (PlasmaInjector const& plasma_injector,
 #endif
     for (MFIter mfi = MakeMFIter(0, info); mfi.isValid(); ++mfi)
     {
-        if (cost && WarpX::load_balance_costs_update_algo == LoadBalanceCostsUpdateAlgo::Timers)
-        {
-            amrex::Gpu::synchronize();
-        }
-        auto wt = static_cast<amrex::Real>(amrex::second());
+        CostTimer cost_timer(0, mfi.index());
 
         const Box& tile_box = mfi.tilebox();
         const RealBox tile_realbox = WarpX::getRealBox(tile_box, 0);
@@ -1949,11 +1969,7 @@ PhysicalParticleContainer::AddPlasmaFlux (PlasmaInjector const& plasma_injector,
 
         amrex::Gpu::synchronize();
 
-        if (cost && WarpX::load_balance_costs_update_algo == LoadBalanceCostsUpdateAlgo::Timers)
-        {
-            wt = static_cast<amrex::Real>(amrex::second()) - wt;
-            amrex::HostDevice::Atomic::Add( &(*cost)[mfi.index()], wt);
-        }
+        cost_timer.record(KernelCost::ParticleCreation);
     }
 
     // Remove particles that are inside the embedded boundaries
@@ -1983,7 +1999,7 @@ PhysicalParticleContainer::Evolve (ablastr::fields::MultiFabRegister& fields,
                                    int lev,
                                    const std::string& current_fp_string,
                                    Real /*t*/, Real dt, DtType a_dt_type, bool skip_deposition,
-                                   PushType push_type)
+                                   PushType push_type, PushRegion push_region)
 {
     using ablastr::fields::Direction;
     using warpx::fields::FieldType;
@@ -1993,8 +2009,6 @@ PhysicalParticleContainer::Evolve (ablastr::fields::MultiFabRegister& fields,
 
     BL_ASSERT(OnSameGrids(lev, *fields.get(FieldType::current_fp, Direction{0}, lev)));
 
-    amrex::LayoutData<amrex::Real>* cost = WarpX::getCosts(lev);
-
     const iMultiFab* current_masks = WarpX::CurrentBufferMasks(lev);
     const iMultiFab* gather_masks = WarpX::GatherBufferMasks(lev);
 
@@ -2003,6 +2017,44 @@ PhysicalParticleContainer::Evolve (ablastr::fields::MultiFabRegister& fields,
     const bool has_E_cax = fields.has_vector(FieldType::Efield_cax, lev);
     const bool has_buffer = has_E_cax || has_J_buf;
 
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+        push_region == PushRegion::All || (!has_buffer && push_type == PushType::Explicit),
+        "The particles can only be pushed by region with the explicit push and without mesh refinement buffers");
+    if (push_region == PushRegion::Interior) { m_num_interior_particles.clear(); }
+
+    // The shape factors at the old position can only be reused by the deposition
+    // if the particles cannot cross more than one cell in a step
+    const bool moves_less_than_one_cell = MovesLessThanOneCell(Geom(lev), dt);
+
+    // Gather, push and deposit the current in a single kernel when possible
+    const bool fuse_push_deposit = m_fuse_push_and_deposit && moves_less_than_one_cell && !has_buffer &&
+        push_region == PushRegion::All && push_type == PushType::Explicit && !skip_deposition && !do_not_deposit
+#ifdef WARPX_QED
+        && !m_do_qed_quantum_sync && !has_quantum_sync()
+#endif
+        ;
+
+    // The fused kernel also deposits the charge at the new time, unless the
+    // charge is deposited with shared memory
+    const bool fuse_push_deposit_rho = fuse_push_deposit && has_rho &&
+        WarpX::electrostatic_solver_id == ElectrostaticSolverAlgo::None &&
+        !WarpX::do_shared_mem_charge_deposition;
+    if (fuse_push_deposit_rho) {
+        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(fields.get(FieldType::rho_fp, lev)->nComp() >= 2,
+            "Cannot deposit charge in rho component 1: only component 0 is allocated!");
+    }
+
+    // Keep the shape factors of the field gather for the Esirkepov deposition of the
+    // same particles (the particles in the buffers gather and deposit on another level)
+    const bool reuse_gather_shapes = m_reuse_gather_shape_factors && moves_less_than_one_cell &&
+        !fuse_push_deposit && !has_buffer && push_type == PushType::Explicit && !skip_deposition &&
+        !do_not_deposit && !do_not_push && !do_not_gather;
+
+    // Only PushPX and PushPXAndDepositCurrent update the cached cell index of the particles
+    const bool update_cell_index = m_cache_cell_index && !do_not_push && !has_buffer &&
+        push_type == PushType::Explicit;
+    if (!do_not_push && !update_cell_index) { InvalidateCellIndex(); }
+
     amrex::MultiFab & Ex = *fields.get(FieldType::Efield_aux, Direction{0}, lev);
     amrex::MultiFab & Ey = *fields.get(FieldType::Efield_aux, Direction{1}, lev);
     amrex::MultiFab & Ez = *fields.get(FieldType::Efield_aux, Direction{2}, lev);
@@ -2036,14 +2088,11 @@ PhysicalParticleContainer::Evolve (ablastr::fields::MultiFabRegister& fields,
 
         FArrayBox filtered_Ex, filtered_Ey, filtered_Ez;
         FArrayBox filtered_Bx, filtered_By, filtered_Bz;
+        NodeShapeFactorsBuffer gather_shape_buffer;
 
         for (WarpXParIter pti(*this, lev); pti.isValid(); ++pti)
         {
-            if (cost && WarpX::load_balance_costs_update_algo == LoadBalanceCostsUpdateAlgo::Timers)
-            {
-                amrex::Gpu::synchronize();
-            }
-            auto wt = static_cast<amrex::Real>(amrex::second());
+            CostTimer cost_timer(lev, pti.index());
 
             const Box& box = pti.validbox();
 
@@ -2096,7 +2145,27 @@ PhysicalParticleContainer::Evolve (ablastr::fields::MultiFabRegister& fields,
                     pti, lev, current_masks, gather_masks );
             }
 
-            const long np_current = has_J_buf ? nfine_current : np;
+            // Only the particles [offset, np_end) are advanced by this call
+            long offset = 0;
+            long np_end = np;
+            if (push_region == PushRegion::Interior) {
+                const long n_interior = do_not_push ? np : PartitionParticlesInInterior(np, pti, lev);
+#ifdef AMREX_USE_OMP
+#pragma omp critical (warpx_num_interior_particles)
+#endif
+                m_num_interior_particles[pti.GetPairIndex()] = n_interior;
+                np_end = n_interior;
+            } else if (push_region == PushRegion::Boundary) {
+                // The particles are not reordered between the two calls
+                const auto it = m_num_interior_particles.find(pti.GetPairIndex());
+                offset = (it != m_num_interior_particles.end()) ? it->second : 0;
+            }
+
+            const long np_current = has_J_buf ? nfine_current : np_end;
+
+            cost_timer.record(KernelCost::GatherPush);
+
+            NodeShapeFactorsArray gather_shapes;
 
             if (has_rho && ! skip_deposition && ! do_not_deposit) {
                 // Deposit charge before particle push, in component 0 of MultiFab rho.
@@ -2105,8 +2174,8 @@ PhysicalParticleContainer::Evolve (ablastr::fields::MultiFabRegister& fields,
                     pti.GetiAttribs("ionizationLevel").dataPtr():nullptr;
 
                 amrex::MultiFab* rho = fields.get(FieldType::rho_fp, lev);
-                DepositCharge(pti, wp, ion_lev, rho, 0, 0,
-                              np_current, thread_num, lev, lev);
+                DepositCharge(pti, wp, ion_lev, rho, 0, offset,
+                              np_current-offset, thread_num, lev, lev);
                 if (has_buffer){
                     amrex::MultiFab* crho = fields.get(FieldType::rho_buf, lev);
                     DepositCharge(pti, wp, ion_lev, crho, 0, np_current,
@@ -2114,9 +2183,15 @@ PhysicalParticleContainer::Evolve (ablastr::fields::MultiFabRegister& fields,
                 }
             }
 
+            cost_timer.record(KernelCost::Deposition);
+
             if (! do_not_push)
             {
-                const long np_gather = has_E_cax ? nfine_gather : np;
+                const long np_gather = has_E_cax ? nfine_gather : np_end;
+
+                if (reuse_gather_shapes) {
+                    gather_shapes = gather_shape_buffer.view(np, WarpX::nox);
+                }
 
                 int e_is_nodal = Ex.is_nodal() and Ey.is_nodal() and Ez.is_nodal();
 
@@ -2124,21 +2199,31 @@ PhysicalParticleContainer::Evolve (ablastr::fields::MultiFabRegister& fields,
                 // Gather and push for particles not in the buffer
                 //
                 WARPX_PROFILE_VAR_START(blp_fg);
-                const auto np_to_push = np_gather;
+                const auto np_to_push = np_gather - offset;
                 const auto gather_lev = lev;
-                if (push_type == PushType::Explicit) {
+                if (push_type == PushType::Explicit && fuse_push_deposit) {
+                    PushPXAndDepositCurrent(pti, exfab, eyfab, ezfab,
+                                            bxfab, byfab, bzfab,
+                                            Ex.nGrowVect(),
+                                            fields.get(current_fp_string, Direction{0}, lev),
+                                            fields.get(current_fp_string, Direction{1}, lev),
+                                            fields.get(current_fp_string, Direction{2}, lev),
+                                            fuse_push_deposit_rho ? fields.get(FieldType::rho_fp, lev) : nullptr,
+                                            thread_num, lev, dt, a_dt_type);
+                } else if (push_type == PushType::Explicit) {
                     PushPX(pti, exfab, eyfab, ezfab,
                            bxfab, byfab, bzfab,
                            Ex.nGrowVect(), e_is_nodal,
-                           0, np_to_push, lev, gather_lev, dt, ScaleFields(false), a_dt_type);
+                           offset, np_to_push, lev, gather_lev, dt, ScaleFields(false), a_dt_type,
+                           gather_shapes);
                 } else if (push_type == PushType::Implicit) {
                     ImplicitPushXP(pti, exfab, eyfab, ezfab,
                                    bxfab, byfab, bzfab,
                                    Ex.nGrowVect(), e_is_nodal,
-                                   0, np_to_push, lev, gather_lev, dt, ScaleFields(false), a_dt_type);
+                                   offset, np_to_push, lev, gather_lev, dt, ScaleFields(false), a_dt_type);
                 }
 
-                if (np_gather < np)
+                if (has_E_cax && np_gather < np)
                 {
                     const IntVect& ref_ratio = WarpX::RefRatio(lev-1);
                     const Box& cbox = amrex::coarsen(box,ref_ratio);
@@ -2191,8 +2276,11 @@ PhysicalParticleContainer::Evolve (ablastr::fields::MultiFabRegister& fields,
 
                 WARPX_PROFILE_VAR_STOP(blp_fg);
 
-                // Current Deposition
-                if (!skip_deposition)
+                // The fused push and deposition is counted as GatherPush
+                cost_timer.record(KernelCost::GatherPush);
+
+                // Current Deposition (already done if fused with the push)
+                if (!skip_deposition && !fuse_push_deposit)
                 {
                     // Deposit at t_{n+1/2} with explicit push
                     const amrex::Real relative_time = (push_type == PushType::Explicit ? -0.5_rt * dt : 0.0_rt);
@@ -2205,8 +2293,8 @@ PhysicalParticleContainer::Evolve (ablastr::fields::MultiFabRegister& fields,
                     amrex::MultiFab * jy = fields.get(current_fp_string, Direction{1}, lev);
                     amrex::MultiFab * jz = fields.get(current_fp_string, Direction{2}, lev);
                     DepositCurrent(pti, wp, uxp, uyp, uzp, ion_lev, jx, jy, jz,
-                                   0, np_current, thread_num,
-                                   lev, lev, dt, relative_time, push_type);
+                                   offset, np_current-offset, thread_num,
+                                   lev, lev, dt, relative_time, push_type, gather_shapes);
 
                     if (has_buffer)
                     {
@@ -2221,7 +2309,7 @@ PhysicalParticleContainer::Evolve (ablastr::fields::MultiFabRegister& fields,
                 } // end of "if electrostatic_solver_id == ElectrostaticSolverAlgo::None"
             } // end of "if do_not_push"
 
-            if (has_rho && ! skip_deposition && ! do_not_deposit) {
+            if (has_rho && ! skip_deposition && ! do_not_deposit && ! fuse_push_deposit_rho) {
                 // Deposit charge after particle push, in component 1 of MultiFab rho.
                 // (Skipped for electrostatic solver, as this may lead to out-of-bounds)
                 if (WarpX::electrostatic_solver_id == ElectrostaticSolverAlgo::None) {
@@ -2232,8 +2320,8 @@ PhysicalParticleContainer::Evolve (ablastr::fields::MultiFabRegister& fields,
                     const int* const AMREX_RESTRICT ion_lev = (do_field_ionization)?
                         pti.GetiAttribs("ionizationLevel").dataPtr():nullptr;
 
-                    DepositCharge(pti, wp, ion_lev, rho, 1, 0,
-                                  np_current, thread_num, lev, lev);
+                    DepositCharge(pti, wp, ion_lev, rho, 1, offset,
+                                  np_current-offset, thread_num, lev, lev);
                     if (has_buffer){
                         amrex::MultiFab* crho = fields.get(FieldType::rho_buf, lev);
                         DepositCharge(pti, wp, ion_lev, crho, 1, np_current,
@@ -2244,21 +2332,21 @@ PhysicalParticleContainer::Evolve (ablastr::fields::MultiFabRegister& fields,
 
             amrex::Gpu::synchronize();
 
-            if (cost && WarpX::load_balance_costs_update_algo == LoadBalanceCostsUpdateAlgo::Timers)
-            {
-                wt = static_cast<amrex::Real>(amrex::second()) - wt;
-                amrex::HostDevice::Atomic::Add( &(*cost)[pti.index()], wt);
-            }
+            cost_timer.record(KernelCost::Deposition);
         }
     }
+    if (update_cell_index) { ValidateCellIndex(); }
+
     // Split particles at the end of the timestep.
     // When subcycling is ON, the splitting is done on the last call to
     // PhysicalParticleContainer::Evolve on the finest level, i.e., at the
     // end of the large timestep. Otherwise, the pushes on different levels
     // are not consistent, and the call to Redistribute (inside
     // SplitParticles) may result in split particles to deposit twice on the
-    // coarse level.
-    if (do_splitting && (a_dt_type == DtType::SecondHalf || a_dt_type == DtType::Full) ){
+    // coarse level. When the push is split by region, this is done after the
+    // boundary particles are pushed.
+    if (do_splitting && push_region != PushRegion::Interior &&
+        (a_dt_type == DtType::SecondHalf || a_dt_type == DtType::Full) ){
         SplitParticles(lev);
     }
 }
@@ -2728,7 +2816,8 @@ PhysicalParticleContainer::PushPX (WarpXParIter& pti,
                                    const long np_to_push,
                                    int lev, int gather_lev,
                                    amrex::Real dt, ScaleFields scaleFields,
-                                   DtType a_dt_type)
+                                   DtType a_dt_type,
+                                   NodeShapeFactorsArray const& gather_shapes)
 {
     WARPX_ALWAYS_ASSERT_WITH_MESSAGE((gather_lev==(lev-1)) ||
                                      (gather_lev==(lev  )),
@@ -2752,17 +2841,7 @@ PhysicalParticleContainer::PushPX (WarpXParIter& pti,
     // Add guard cells to the box.
     box.grow(ngEB);
 
-    const auto getPosition = GetParticlePosition<PIdx>(pti, offset);
-          auto setPosition = SetParticlePosition<PIdx>(pti, offset);
-
-    const auto getExternalEB = GetExternalEBField(pti, offset);
-
-    const amrex::ParticleReal Ex_external_particle = m_E_external_particle[0];
-    const amrex::ParticleReal Ey_external_particle = m_E_external_particle[1];
-    const amrex::ParticleReal Ez_external_particle = m_E_external_particle[2];
-    const amrex::ParticleReal Bx_external_particle = m_B_external_particle[0];
-    const amrex::ParticleReal By_external_particle = m_B_external_particle[1];
-    const amrex::ParticleReal Bz_external_particle = m_B_external_particle[2];
+    const PushPXKernel pusher = GetPushPXKernel(pti, offset, dt, a_dt_type);
 
     // Lower corner of tile box physical domain (take into account Galilean shift)
     const amrex::XDim3 xyzmin = WarpX::LowerCorner(box, gather_lev, 0._rt);
@@ -2787,171 +2866,328 @@ PhysicalParticleContainer::PushPX (WarpXParIter& pti,
     amrex::IndexType const by_type = byfab->box().ixType();
     amrex::IndexType const bz_type = bzfab->box().ixType();
 
-    auto& attribs = pti.GetAttribs();
-    ParticleReal* const AMREX_RESTRICT ux = attribs[PIdx::ux].dataPtr() + offset;
-    ParticleReal* const AMREX_RESTRICT uy = attribs[PIdx::uy].dataPtr() + offset;
-    ParticleReal* const AMREX_RESTRICT uz = attribs[PIdx::uz].dataPtr() + offset;
+    const auto t_do_not_gather = do_not_gather;
 
-    const int do_copy = (m_do_back_transformed_particles && (a_dt_type!=DtType::SecondHalf) );
-    CopyParticleAttribs copyAttribs;
-    if (do_copy) {
-        copyAttribs = CopyParticleAttribs(pti, tmp_particle_data, offset);
-    }
+    const int push_runtime_flag = selectPushKernel(pusher.m_pusher_algo, pusher.m_do_crr,
+                                                   pusher.m_ion_lev != nullptr);
+
+    // Using this version of ParallelFor with compile time options
+    // improves performance when qed or external EB are not used by reducing
+    // register pressure. Species with a plain Boris push (no ionization, no
+    // radiation reaction) also skip the per-particle pusher selection.
+    amrex::ParallelFor(
+        TypeList<CompileTimeOptions<PushPXKernel::no_exteb,PushPXKernel::has_exteb>,
+                 CompileTimeOptions<PushPXKernel::no_qed  ,PushPXKernel::has_qed>,
+                 CompileTimeOptions<generic_push,boris_push>>{},
+        {pusher.extebFlag(), pusher.qedFlag(), push_runtime_flag},
+        np_to_push,
+        [=] AMREX_GPU_DEVICE (long ip, auto exteb_control, auto qed_control, auto push_control)
+    {
+        amrex::ParticleReal xp, yp, zp;
+        pusher.getOldPosition(ip, xp, yp, zp);
+
+        amrex::ParticleReal Exp, Eyp, Ezp, Bxp, Byp, Bzp;
+        pusher.initFields(Exp, Eyp, Ezp, Bxp, Byp, Bzp);
+
+        if(!t_do_not_gather){
+            // first gather E and B to the particle positions
+            doGatherShapeN(xp, yp, zp, Exp, Eyp, Ezp, Bxp, Byp, Bzp,
+                           ex_arr, ey_arr, ez_arr, bx_arr, by_arr, bz_arr,
+                           ex_type, ey_type, ez_type, bx_type, by_type, bz_type,
+                           dinv, xyzmin, lo, n_rz_azimuthal_modes,
+                           nox, galerkin_interpolation, gather_shapes, ip);
+        }
+
+        pusher.addExternalFields<exteb_control>(ip, Exp, Eyp, Ezp, Bxp, Byp, Bzp);
+
+        scaleFields(xp, yp, zp, Exp, Eyp, Ezp, Bxp, Byp, Bzp);
+
+        pusher.push<qed_control, push_control>(ip, xp, yp, zp, Exp, Eyp, Ezp, Bxp, Byp, Bzp);
+    });
+}
+
+PushPXKernel
+PhysicalParticleContainer::GetPushPXKernel (WarpXParIter& pti, const long offset,
+                                            const amrex::Real dt, DtType a_dt_type)
+{
+    PushPXKernel pusher;
+
+    pusher.m_get_position = GetParticlePosition<PIdx>(pti, offset);
+    pusher.m_set_position = SetParticlePosition<PIdx>(pti, offset);
+    pusher.m_set_cell_index = SetParticleCellIndex(pti, *this, offset);
+    pusher.m_update_cell_index = !pusher.m_set_cell_index.isNoOp();
+    pusher.m_get_external_eb = GetExternalEBField(pti, offset);
+
+    pusher.m_Ex_external = m_E_external_particle[0];
+    pusher.m_Ey_external = m_E_external_particle[1];
+    pusher.m_Ez_external = m_E_external_particle[2];
+    pusher.m_Bx_external = m_B_external_particle[0];
+    pusher.m_By_external = m_B_external_particle[1];
+    pusher.m_Bz_external = m_B_external_particle[2];
+
+    auto& attribs = pti.GetAttribs();
+    pusher.m_ux = attribs[PIdx::ux].dataPtr() + offset;
+    pusher.m_uy = attribs[PIdx::uy].dataPtr() + offset;
+    pusher.m_uz = attribs[PIdx::uz].dataPtr() + offset;
 
-    int* AMREX_RESTRICT ion_lev = nullptr;
     if (do_field_ionization) {
-        ion_lev = pti.GetiAttribs("ionizationLevel").dataPtr() + offset;
+        pusher.m_ion_lev = pti.GetiAttribs("ionizationLevel").dataPtr() + offset;
     }
 
-    const bool save_previous_position = m_save_previous_position;
-    ParticleReal* x_old = nullptr;
-    ParticleReal* y_old = nullptr;
-    ParticleReal* z_old = nullptr;
-    if (save_previous_position) {
+    pusher.m_save_previous_position = m_save_previous_position;
+    if (m_save_previous_position) {
 #if (AMREX_SPACEDIM >= 2)
-        x_old = pti.GetAttribs("prev_x").dataPtr() + offset;
+        pusher.m_x_old = pti.GetAttribs("prev_x").dataPtr() + offset;
 #endif
 #if defined(WARPX_DIM_3D)
-        y_old = pti.GetAttribs("prev_y").dataPtr() + offset;
+        pusher.m_y_old = pti.GetAttribs("prev_y").dataPtr() + offset;
 #endif
-        z_old = pti.GetAttribs("prev_z").dataPtr() + offset;
-        amrex::ignore_unused(x_old, y_old);
+        pusher.m_z_old = pti.GetAttribs("prev_z").dataPtr() + offset;
     }
 
-    // Loop over the particles and update their momentum
-    const amrex::ParticleReal q = this->charge;
-    const amrex::ParticleReal m = this-> mass;
+    pusher.m_do_copy = (m_do_back_transformed_particles && (a_dt_type!=DtType::SecondHalf) );
+    if (pusher.m_do_copy) {
+        pusher.m_copy_attribs = CopyParticleAttribs(pti, tmp_particle_data, offset);
+    }
 
-    const auto pusher_algo = WarpX::particle_pusher_algo;
-    const auto do_crr = do_classical_radiation_reaction;
-#ifdef WARPX_QED
-    const auto do_sync = m_do_qed_quantum_sync;
-    amrex::Real t_chi_max = 0.0;
-    if (do_sync) { t_chi_max = m_shr_p_qs_engine->get_minimum_chi_part(); }
+    pusher.m_q = this->charge;
+    pusher.m_m = this->mass;
+    pusher.m_pusher_algo = WarpX::particle_pusher_algo;
+    pusher.m_do_crr = do_classical_radiation_reaction;
+    pusher.m_dt = dt;
 
-    QuantumSynchrotronEvolveOpticalDepth evolve_opt;
-    amrex::ParticleReal* AMREX_RESTRICT p_optical_depth_QSR = nullptr;
-    const bool local_has_quantum_sync = has_quantum_sync();
-    if (local_has_quantum_sync) {
-        evolve_opt = m_shr_p_qs_engine->build_evolve_functor();
-        p_optical_depth_QSR = pti.GetAttribs("opticalDepthQSR").dataPtr()  + offset;
+#ifdef WARPX_QED
+    pusher.m_do_sync = m_do_qed_quantum_sync;
+    if (pusher.m_do_sync) { pusher.m_t_chi_max = m_shr_p_qs_engine->get_minimum_chi_part(); }
+    pusher.m_has_quantum_sync = has_quantum_sync();
+    if (pusher.m_has_quantum_sync) {
+        pusher.m_evolve_opt = m_shr_p_qs_engine->build_evolve_functor();
+        pusher.m_optical_depth_QSR = pti.GetAttribs("opticalDepthQSR").dataPtr() + offset;
     }
 #endif
 
-    const auto t_do_not_gather = do_not_gather;
+    return pusher;
+}
 
-    enum exteb_flags : int { no_exteb, has_exteb };
-    enum qed_flags : int { no_qed, has_qed };
+void
+PhysicalParticleContainer::PushPXAndDepositCurrent (WarpXParIter& pti,
+                                                    amrex::FArrayBox const * exfab,
+                                                    amrex::FArrayBox const * eyfab,
+                                                    amrex::FArrayBox const * ezfab,
+                                                    amrex::FArrayBox const * bxfab,
+                                                    amrex::FArrayBox const * byfab,
+                                                    amrex::FArrayBox const * bzfab,
+                                                    const amrex::IntVect ngEB,
+                                                    amrex::MultiFab* jx,
+                                                    amrex::MultiFab* jy,
+                                                    amrex::MultiFab* jz,
+                                                    amrex::MultiFab* rho,
+                                                    [[maybe_unused]] const int thread_num,
+                                                    const int lev,
+                                                    const amrex::Real dt,
+                                                    DtType a_dt_type)
+{
+    const long np_to_push = pti.numParticles();
 
-    const int exteb_runtime_flag = getExternalEB.isNoOp() ? no_exteb : has_exteb;
-#ifdef WARPX_QED
-    const int qed_runtime_flag = (local_has_quantum_sync || do_sync) ? has_qed : no_qed;
+    // If no particles, do not do anything
+    if (np_to_push == 0) { return; }
+
+#if defined(WARPX_DIM_RZ)
+    amrex::ignore_unused(exfab, eyfab, ezfab, bxfab, byfab, bzfab, ngEB,
+                         jx, jy, jz, rho, lev, dt, a_dt_type);
+    WARPX_ABORT_WITH_MESSAGE("The fused push and current deposition is not implemented in RZ geometry");
+#else
+    const amrex::XDim3 dinv = WarpX::InvCellSize(lev);
+
+    // Box from which the fields are gathered, with guard cells
+    Box gather_box = pti.tilebox();
+    gather_box.grow(ngEB);
+    const amrex::XDim3 xyzmin_gather = WarpX::LowerCorner(gather_box, lev, 0._rt);
+    const Dim3 lo_gather = lbound(gather_box);
+
+    // Box on which the current is deposited, with guard cells (as in DepositCurrent)
+    const WarpX& warpx = WarpX::GetInstance();
+    const amrex::IntVect& ng_J = warpx.get_ng_depos_J();
+    Box depos_box = pti.tilebox();
+#ifndef AMREX_USE_GPU
+    // Staggered tile boxes (different in each direction)
+    const Box tbx = amrex::grow(convert(depos_box, jx->ixType().toIntVect()), ng_J);
+    const Box tby = amrex::grow(convert(depos_box, jy->ixType().toIntVect()), ng_J);
+    const Box tbz = amrex::grow(convert(depos_box, jz->ixType().toIntVect()), ng_J);
+#endif
+    depos_box.grow(ng_J);
+    const amrex::XDim3 xyzmin_depos = WarpX::LowerCorner(depos_box, lev, 0.5_rt*dt);
+    const Dim3 lo_depos = lbound(depos_box);
+
+    // Offset between the indices of the gather box and of the deposition box,
+    // used to move the shape factors of the gather onto the current arrays
+    const Dim3 lo_shift = {lo_gather.x - lo_depos.x,
+                           lo_gather.y - lo_depos.y,
+                           lo_gather.z - lo_depos.z};
+
+    // Box on which the charge at the new time is deposited, in component 1
+    // of rho, with guard cells (as in DepositCharge)
+    const bool deposit_rho = (rho != nullptr);
+    const int nc = WarpX::ncomps;
+    const amrex::IntVect& ng_rho = warpx.get_ng_depos_rho();
+    const amrex::IntVect rho_type = deposit_rho ? rho->ixType().toIntVect() : amrex::IntVect::TheNodeVector();
+    Box rho_box = pti.tilebox();
+#ifndef AMREX_USE_GPU
+    const Box tbrho = amrex::grow(convert(rho_box, rho_type), ng_rho);
+#endif
+    rho_box.grow(ng_rho);
+    const amrex::XDim3 xyzmin_rho = WarpX::LowerCorner(rho_box, lev, dt);
+    const Dim3 lo_rho = lbound(rho_box);
+
+#ifdef AMREX_USE_GPU
+    // GPU, no tiling: j<xyz>_arr and rho_arr point to the full arrays
+    Array4<Real> const& jx_arr = jx->array(pti);
+    Array4<Real> const& jy_arr = jy->array(pti);
+    Array4<Real> const& jz_arr = jz->array(pti);
+    Array4<Real> rho_arr;
+    if (deposit_rho) { rho_arr = rho->array(pti, nc); }
 #else
-    int qed_runtime_flag = no_qed;
+    // CPU, tiling: j<xyz>_arr and rho_arr point to the local_j<xyz>[thread_num]
+    // and local_rho[thread_num] arrays
+    local_jx[thread_num].resize(tbx, jx->nComp());
+    local_jy[thread_num].resize(tby, jy->nComp());
+    local_jz[thread_num].resize(tbz, jz->nComp());
+    local_jx[thread_num].setVal(0.0);
+    local_jy[thread_num].setVal(0.0);
+    local_jz[thread_num].setVal(0.0);
+    Array4<Real> const& jx_arr = local_jx[thread_num].array();
+    Array4<Real> const& jy_arr = local_jy[thread_num].array();
+    Array4<Real> const& jz_arr = local_jz[thread_num].array();
+    Array4<Real> rho_arr;
+    if (deposit_rho) {
+        local_rho[thread_num].resize(tbrho, nc);
+        local_rho[thread_num].setVal(0.0);
+        rho_arr = local_rho[thread_num].array();
+    }
 #endif
 
-    // Using this version of ParallelFor with compile time options
-    // improves performance when qed or external EB are not used by reducing
-    // register pressure.
+    // The quantum synchrotron process is not handled here (Evolve uses PushPX instead)
+    const PushPXKernel pusher = GetPushPXKernel(pti, 0, dt, a_dt_type);
+
+    const int n_rz_azimuthal_modes = WarpX::n_rz_azimuthal_modes;
+
+    amrex::Array4<const amrex::Real> const& ex_arr = exfab->array();
+    amrex::Array4<const amrex::Real> const& ey_arr = eyfab->array();
+    amrex::Array4<const amrex::Real> const& ez_arr = ezfab->array();
+    amrex::Array4<const amrex::Real> const& bx_arr = bxfab->array();
+    amrex::Array4<const amrex::Real> const& by_arr = byfab->array();
+    amrex::Array4<const amrex::Real> const& bz_arr = bzfab->array();
+
+    amrex::IndexType const ex_type = exfab->box().ixType();
+    amrex::IndexType const ey_type = eyfab->box().ixType();
+    amrex::IndexType const ez_type = ezfab->box().ixType();
+    amrex::IndexType const bx_type = bxfab->box().ixType();
+    amrex::IndexType const by_type = byfab->box().ixType();
+    amrex::IndexType const bz_type = bzfab->box().ixType();
+
+    const ParticleReal* const AMREX_RESTRICT wp = pti.GetAttribs(PIdx::w).dataPtr();
+
+    const auto t_do_not_gather = do_not_gather;
+
+    // Inverse cell surface normal to each direction, divided by dt, and inverse cell volume
+    const amrex::XDim3 invdtd = amrex::XDim3{(1.0_rt/dt)*dinv.y*dinv.z,
+                                             (1.0_rt/dt)*dinv.x*dinv.z,
+                                             (1.0_rt/dt)*dinv.x*dinv.y};
+    const amrex::Real invvol = dinv.x*dinv.y*dinv.z;
+
+    const int galerkin_runtime_flag = WarpX::galerkin_interpolation ? 1 : 0;
+
     amrex::ParallelFor(
-        TypeList<CompileTimeOptions<no_exteb,has_exteb>, CompileTimeOptions<no_qed  ,has_qed>>{},
-        {exteb_runtime_flag, qed_runtime_flag},
+        TypeList<CompileTimeOptions<1,2,3,4>,
+                 CompileTimeOptions<0,1>,
+                 CompileTimeOptions<PushPXKernel::no_exteb,PushPXKernel::has_exteb>>{},
+        {WarpX::nox, galerkin_runtime_flag, pusher.extebFlag()},
         np_to_push,
-        [=] AMREX_GPU_DEVICE (long ip, auto exteb_control, auto qed_control)
+        [=] AMREX_GPU_DEVICE (long ip, auto order_control, auto galerkin_control, auto exteb_control)
     {
-        amrex::ParticleReal xp, yp, zp;
-        getPosition(ip, xp, yp, zp);
+        constexpr int depos_order = decltype(order_control)::value;
+        constexpr int galerkin_interpolation = decltype(galerkin_control)::value;
 
-        if (save_previous_position) {
-#if (AMREX_SPACEDIM >= 2)
-            x_old[ip] = xp;
+        amrex::ParticleReal xp, yp, zp;
+        pusher.getOldPosition(ip, xp, yp, zp);
+
+        amrex::ParticleReal Exp, Eyp, Ezp, Bxp, Byp, Bzp;
+        pusher.initFields(Exp, Eyp, Ezp, Bxp, Byp, Bzp);
+
+        // Node-centered shape factors at the old position, computed by the gather
+        // and reused below for the current deposition
+        NodeShapeFactors<depos_order> old_shape;
+        if (!t_do_not_gather) {
+            doGatherShapeN<depos_order, galerkin_interpolation>(
+                xp, yp, zp, Exp, Eyp, Ezp, Bxp, Byp, Bzp,
+                ex_arr, ey_arr, ez_arr, bx_arr, by_arr, bz_arr,
+                ex_type, ey_type, ez_type, bx_type, by_type, bz_type,
+                dinv, xyzmin_gather, lo_gather, n_rz_azimuthal_modes, &old_shape);
+        } else {
+            const Compute_shape_factor< depos_order > compute_shape_factor;
+#if !defined(WARPX_DIM_1D_Z)
+            old_shape.ix = compute_shape_factor(old_shape.sx, static_cast<double>((xp - xyzmin_gather.x)*dinv.x));
 #endif
 #if defined(WARPX_DIM_3D)
-            y_old[ip] = yp;
+            old_shape.iy = compute_shape_factor(old_shape.sy, static_cast<double>((yp - xyzmin_gather.y)*dinv.y));
 #endif
-            z_old[ip] = zp;
+            old_shape.iz = compute_shape_factor(old_shape.sz, static_cast<double>((zp - xyzmin_gather.z)*dinv.z));
         }
 
-        amrex::ParticleReal Exp = Ex_external_particle;
-        amrex::ParticleReal Eyp = Ey_external_particle;
-        amrex::ParticleReal Ezp = Ez_external_particle;
-        amrex::ParticleReal Bxp = Bx_external_particle;
-        amrex::ParticleReal Byp = By_external_particle;
-        amrex::ParticleReal Bzp = Bz_external_particle;
+        pusher.addExternalFields<exteb_control>(ip, Exp, Eyp, Ezp, Bxp, Byp, Bzp);
 
-        if(!t_do_not_gather){
-            // first gather E and B to the particle positions
-            doGatherShapeN(xp, yp, zp, Exp, Eyp, Ezp, Bxp, Byp, Bzp,
-                           ex_arr, ey_arr, ez_arr, bx_arr, by_arr, bz_arr,
-                           ex_type, ey_type, ez_type, bx_type, by_type, bz_type,
-                           dinv, xyzmin, lo, n_rz_azimuthal_modes,
-                           nox, galerkin_interpolation);
-        }
-
-        [[maybe_unused]] const auto& getExternalEB_tmp = getExternalEB;
-        if constexpr (exteb_control == has_exteb) {
-            getExternalEB(ip, Exp, Eyp, Ezp, Bxp, Byp, Bzp);
-        }
+        pusher.push<PushPXKernel::no_qed, generic_push>(ip, xp, yp, zp, Exp, Eyp, Ezp, Bxp, Byp, Bzp);
 
-        scaleFields(xp, yp, zp, Exp, Eyp, Ezp, Bxp, Byp, Bzp);
-
-#ifdef WARPX_QED
-        if (!do_sync)
-#endif
-        {
-            if (do_copy) {
-                //  Copy the old x and u for the BTD
-                copyAttribs(ip);
-            }
+        // Deposit the current between the old and new positions, and the charge
+        // at the new position, while the particle data is still in registers
+        const amrex::ParticleReal uxp = pusher.m_ux[ip];
+        const amrex::ParticleReal uyp = pusher.m_uy[ip];
+        const amrex::ParticleReal uzp = pusher.m_uz[ip];
+        constexpr amrex::Real inv_c2 = 1._rt/(PhysConst::c*PhysConst::c);
+        const amrex::Real gaminv = 1.0_rt/std::sqrt(1.0_rt + (uxp*uxp + uyp*uyp + uzp*uzp)*inv_c2);
+        amrex::Real wq = pusher.m_q*wp[ip];
+        if (pusher.m_ion_lev) { wq *= pusher.m_ion_lev[ip]; }
 
-            doParticleMomentumPush<0>(ux[ip], uy[ip], uz[ip],
-                                      Exp, Eyp, Ezp, Bxp, Byp, Bzp,
-                                      ion_lev ? ion_lev[ip] : 1,
-                                      m, q, pusher_algo, do_crr,
-#ifdef WARPX_QED
-                                      t_chi_max,
+        // Move the old shape factors to the indices of the deposition box
+        // Keep the new positions double to avoid bug in single precision
+        double x_new = 0., y_new = 0.;
+#if defined(WARPX_DIM_3D)
+        x_new = (xp - xyzmin_depos.x)*dinv.x;
+        y_new = (yp - xyzmin_depos.y)*dinv.y;
+        old_shape.ix += lo_shift.x;
+        old_shape.iy += lo_shift.y;
+        old_shape.iz += lo_shift.z;
+#elif defined(WARPX_DIM_XZ)
+        x_new = (xp - xyzmin_depos.x)*dinv.x;
+        old_shape.ix += lo_shift.x;
+        old_shape.iz += lo_shift.y;
+#elif defined(WARPX_DIM_1D_Z)
+        old_shape.iz += lo_shift.x;
 #endif
-                                      dt);
+        const double z_new = (zp - xyzmin_depos.z)*dinv.z;
 
-            UpdatePosition(xp, yp, zp, ux[ip], uy[ip], uz[ip], dt);
-            setPosition(ip, xp, yp, zp);
-        }
-#ifdef WARPX_QED
-        else {
-            if constexpr (qed_control == has_qed) {
-                if (do_copy) {
-                    //  Copy the old x and u for the BTD
-                    copyAttribs(ip);
-                }
+        doEsirkepovDepositionShapeNKernel<depos_order>(
+            x_new, y_new, z_new, old_shape,
+            uxp*gaminv, uyp*gaminv, wq,
+            jx_arr, jy_arr, jz_arr, invdtd, invvol, lo_depos);
 
-                doParticleMomentumPush<1>(ux[ip], uy[ip], uz[ip],
-                                          Exp, Eyp, Ezp, Bxp, Byp, Bzp,
-                                          ion_lev ? ion_lev[ip] : 1,
-                                          m, q, pusher_algo, do_crr,
-                                          t_chi_max,
-                                          dt);
-
-                UpdatePosition(xp, yp, zp, ux[ip], uy[ip], uz[ip], dt);
-                setPosition(ip, xp, yp, zp);
-            }
+        if (deposit_rho) {
+            doChargeDepositionShapeNKernel<depos_order>(
+                xp, yp, zp, wq*invvol, rho_arr, rho_type,
+                dinv, xyzmin_rho, lo_rho, n_rz_azimuthal_modes);
         }
-#endif
+    });
 
-#ifdef WARPX_QED
-        [[maybe_unused]] auto foo_local_has_quantum_sync = local_has_quantum_sync;
-        [[maybe_unused]] auto *foo_podq = p_optical_depth_QSR;
-        [[maybe_unused]] const auto& foo_evolve_opt = evolve_opt; // have to do all these for nvcc
-        if constexpr (qed_control == has_qed) {
-            if (local_has_quantum_sync) {
-                evolve_opt(ux[ip], uy[ip], uz[ip],
-                           Exp, Eyp, Ezp,Bxp, Byp, Bzp,
-                           dt, p_optical_depth_QSR[ip]);
-            }
-        }
-#else
-            amrex::ignore_unused(qed_control);
+#ifndef AMREX_USE_GPU
+    // CPU, tiling: atomicAdd local_j<xyz> and local_rho into j<xyz> and rho
+    (*jx)[pti].lockAdd(local_jx[thread_num], tbx, tbx, 0, 0, jx->nComp());
+    (*jy)[pti].lockAdd(local_jy[thread_num], tby, tby, 0, 0, jy->nComp());
+    (*jz)[pti].lockAdd(local_jz[thread_num], tbz, tbz, 0, 0, jz->nComp());
+    if (deposit_rho) {
+        (*rho)[pti].lockAdd(local_rho[thread_num], tbrho, tbrho, 0, nc, nc);
+    }
 #endif
-    });
+#endif // defined(WARPX_DIM_RZ)
 }
 
 /* \brief Perform the implicit particle push operation in one fused kernel
@@ -85,7 +85,8 @@ void VelocityCoincidenceThinning::operator() (WarpXParIter& pti, const int lev,
     auto * const AMREX_RESTRICT idcpu = soa.GetIdCPUData().data();
 
     // Using this function means that we must loop over the cells in the ParallelFor.
-    auto bins = ParticleUtils::findParticlesInEachCell(lev, pti, ptile);
+    auto bins = ParticleUtils::findParticlesInEachCell(lev, pti, ptile,
+                                                      GetParticleCellIndex(*pc, lev));
 
     const auto n_cells = static_cast<int>(bins.numBins());
     auto *const indices = bins.permutationPtr();
@@ -58,8 +58,14 @@ using namespace amrex;
 
 RigidInjectedParticleContainer::RigidInjectedParticleContainer (AmrCore* amr_core, int ispecies,
                                                                 const std::string& name)
-    : PhysicalParticleContainer(amr_core, ispecies, name)
+    : PhysicalParticleContainer(amr_core, ispecies, name, false)
 {
+    // The rigid advance is done in PushPX, which does not implement the fused
+    // push-deposit kernel, the update of the cached cell index (so the
+    // cell index is not cached, see above) nor the storage of the gather
+    // shape factors
+    m_fuse_push_and_deposit = false;
+    m_reuse_gather_shape_factors = false;
 
     const ParmParse pp_species_name(species_name);
 
@@ -167,7 +173,8 @@ RigidInjectedParticleContainer::PushPX (WarpXParIter& pti,
                                         const long np_to_push,
                                         int lev, int gather_lev,
                                         amrex::Real dt, ScaleFields /*scaleFields*/,
-                                        DtType a_dt_type)
+                                        DtType a_dt_type,
+                                        NodeShapeFactorsArray const& /*gather_shapes*/)
 {
     auto& attribs = pti.GetAttribs();
     auto& uxp = attribs[PIdx::ux];
@@ -251,27 +258,30 @@ RigidInjectedParticleContainer::Evolve (ablastr::fields::MultiFabRegister& field
                                         int lev,
                                         const std::string& current_fp_string,
                                         Real t, Real dt, DtType a_dt_type, bool skip_deposition,
-                                        PushType push_type)
+                                        PushType push_type, PushRegion push_region)
 {
 
     // Update location of injection plane in the boosted frame
-    zinject_plane_lev_previous = zinject_plane_levels[lev];
-    zinject_plane_levels[lev] -= dt*WarpX::beta_boost*PhysConst::c;
-    zinject_plane_lev = zinject_plane_levels[lev];
-
-    // Set the done injecting flag when the inject plane moves out of the
-    // simulation domain.
-    // It is much easier to do this check, rather than checking if all of the
-    // particles have crossed the inject plane.
-    const Real* plo = Geom(lev).ProbLo();
-    const Real* phi = Geom(lev).ProbHi();
-    done_injecting_lev = ((zinject_plane_levels[lev] < plo[WARPX_ZINDEX] && WarpX::moving_window_v + WarpX::beta_boost*PhysConst::c >= 0.) ||
-                           (zinject_plane_levels[lev] > phi[WARPX_ZINDEX] && WarpX::moving_window_v + WarpX::beta_boost*PhysConst::c <= 0.));
+    // (only once per step, when the push is split by region)
+    if (push_region != PushRegion::Boundary) {
+        zinject_plane_lev_previous = zinject_plane_levels[lev];
+        zinject_plane_levels[lev] -= dt*WarpX::beta_boost*PhysConst::c;
+        zinject_plane_lev = zinject_plane_levels[lev];
+
+        // Set the done injecting flag when the inject plane moves out of the
+        // simulation domain.
+        // It is much easier to do this check, rather than checking if all of the
+        // particles have crossed the inject plane.
+        const Real* plo = Geom(lev).ProbLo();
+        const Real* phi = Geom(lev).ProbHi();
+        done_injecting_lev = ((zinject_plane_levels[lev] < plo[WARPX_ZINDEX] && WarpX::moving_window_v + WarpX::beta_boost*PhysConst::c >= 0.) ||
+                               (zinject_plane_levels[lev] > phi[WARPX_ZINDEX] && WarpX::moving_window_v + WarpX::beta_boost*PhysConst::c <= 0.));
+    }
 
     PhysicalParticleContainer::Evolve (fields,
                                        lev,
                                        current_fp_string,
-                                       t, dt, a_dt_type, skip_deposition, push_type);
+                                       t, dt, a_dt_type, skip_deposition, push_type, push_region);
 }
 
 void
@@ -0,0 +1,162 @@
+/* Copyright 2025 The WarpX Community
+ *
+ * This file is part of WarpX.
+ *
+ * License: BSD-3-Clause-LBNL
+ */
+#include "CellIndex.H"
+
+#include "Particles/WarpXParticleContainer.H"
+#include "Utils/WarpXProfilerWrapper.H"
+
+#include <AMReX_Box.H>
+#include <AMReX_DenseBins.H>
+#include <AMReX_Geometry.H>
+#include <AMReX_GpuContainers.H>
+#include <AMReX_GpuControl.H>
+#include <AMReX_GpuLaunch.H>
+#include <AMReX_GpuQualifiers.H>
+#include <AMReX_IntVect.H>
+#include <AMReX_MFIter.H>
+#include <AMReX_ParticleUtil.H>
+#include <AMReX_Reduce.H>
+
+#include <algorithm>
+#include <map>
+#include <utility>
+#include <vector>
+
+#ifndef AMREX_USE_GPU
+namespace
+{
+    /** Merge the particles that left their bin since the last sort into the
+     *  particles that are still in order, and return the resulting permutation.
+     *
+     *  The particles that are kept in place form a non-decreasing subsequence of
+     *  `bin`; a particle that is ahead of its successor is considered moved, so
+     *  that a single particle jumping to a later bin does not disorder the rest.
+     *  Only the moved particles are sorted, the two sorted sequences are then merged.
+     */
+    void mergeMovedParticles (const unsigned int* bin, int np,
+                              amrex::Gpu::DeviceVector<unsigned int>& perm)
+    {
+        std::vector<unsigned int> kept, moved;
+        kept.reserve(np);
+        unsigned int last_kept = 0;
+        for (int i = 0; i < np; ++i) {
+            const bool ahead = (i + 1 < np) && (bin[i] > bin[i+1]);
+            if (!ahead && bin[i] >= last_kept) {
+                kept.push_back(i);
+                last_kept = bin[i];
+            } else {
+                moved.push_back(i);
+            }
+        }
+
+        auto by_bin = [bin] (unsigned int a, unsigned int b) { return bin[a] < bin[b]; };
+        std::stable_sort(moved.begin(), moved.end(), by_bin);
+
+        perm.resize(np);
+        std::merge(kept.begin(), kept.end(), moved.begin(), moved.end(), perm.begin(), by_bin);
+    }
+}
+#endif
+
+/* \brief Same as amrex::ParticleContainer::SortParticlesByBin, but only sorts
+ *        the tiles in which the fraction of particles that are out of order
+ *        exceeds `threshold`. In CPU builds, the out-of-order particles are merged
+ *        into the particles that are still sorted instead of binning the whole tile.
+ *        The permutations are computed by the threads in parallel, and applied
+ *        with ReorderParticles after the OpenMP region.
+ */
+int
+WarpXParticleContainer::SortDisorderedTilesByBin (amrex::IntVect bin_size, amrex::Real threshold)
+{
+    WARPX_PROFILE("WarpXParticleContainer::SortDisorderedTilesByBin");
+
+    if (bin_size == amrex::IntVect::TheZeroVector()) { return 0; }
+
+    int num_sorted = 0;
+
+    for (int lev = 0; lev <= finestLevel(); ++lev)
+    {
+        const amrex::Geometry& geom = Geom(lev);
+        const auto plo = geom.ProbLoArray();
+        const auto dxi = geom.InvCellSizeArray();
+        const amrex::Box domain = geom.Domain();
+        const auto get_cell_index = GetParticleCellIndex(*this, lev);
+        const bool use_cell_index = !get_cell_index.isNoOp();
+
+        // Permutation of each tile to sort, indexed by grid and tile index
+        std::map<std::pair<int,int>, amrex::Gpu::DeviceVector<unsigned int>> permutations;
+
+#ifdef AMREX_USE_OMP
+#pragma omp parallel if (amrex::Gpu::notInLaunchRegion()) reduction(+:num_sorted)
+#endif
+        for (amrex::MFIter mfi = MakeMFIter(lev); mfi.isValid(); ++mfi)
+        {
+            auto& ptile = ParticlesAt(lev, mfi);
+            const int np = static_cast<int>(ptile.numParticles());
+            if (np < 2) { continue; }
+
+            const amrex::Box box = mfi.validbox();
+
+            auto get_bin = [=] AMREX_GPU_HOST_DEVICE (const ParticleType& p) -> unsigned int
+            {
+                const amrex::IntVect iv = use_cell_index ?
+                    get_cell_index(p, box) : amrex::getParticleCell(p, plo, dxi, domain);
+                amrex::Box tbox;
+                return static_cast<unsigned int>(
+                    amrex::getTileIndex(iv, box, true, bin_size, tbox));
+            };
+
+            // Disorder metric: fraction of particles in a lower bin than their predecessor.
+            // It is zero right after a sort, and each particle that changes bin adds at most two.
+            amrex::Gpu::DeviceVector<unsigned int> bin(np);
+            unsigned int* const AMREX_RESTRICT pbin = bin.dataPtr();
+            const auto ptd = ptile.getParticleTileData();
+            amrex::ParallelFor(np, [=] AMREX_GPU_DEVICE (int i) noexcept
+            {
+                pbin[i] = get_bin(ParticleType(ptd, i));
+            });
+            const int num_descents = amrex::Reduce::Sum<int>(np - 1,
+                [=] AMREX_GPU_DEVICE (int i) noexcept -> int
+                {
+                    return (pbin[i+1] < pbin[i]) ? 1 : 0;
+                });
+            if (static_cast<amrex::Real>(num_descents) <= threshold*static_cast<amrex::Real>(np)) {
+                continue;
+            }
+            ++num_sorted;
+
+            amrex::Gpu::DeviceVector<unsigned int> perm(np);
+#ifdef AMREX_USE_GPU
+            const int ntiles = amrex::numTilesInBox(box, true, bin_size);
+            amrex::DenseBins<ParticleTileType::ParticleTileDataType> bins;
+            bins.build(np, ptd, ntiles, get_bin);
+            amrex::Gpu::copyAsync(amrex::Gpu::deviceToDevice, bins.permutationPtr(),
+                                  bins.permutationPtr() + np, perm.begin());
+            amrex::Gpu::streamSynchronize();
+#else
+            mergeMovedParticles(pbin, np, perm);
+#endif
+
+#ifdef AMREX_USE_OMP
+#pragma omp critical (sort_disordered_tiles)
+#endif
+            permutations.emplace(std::make_pair(mfi.index(), mfi.LocalTileIndex()), std::move(perm));
+        }
+
+        // Reorder the tiles one after the other, outside of the OpenMP region,
+        // since ReorderParticles is not meant to be called concurrently
+        if (permutations.empty()) { continue; }
+        for (amrex::MFIter mfi = MakeMFIter(lev); mfi.isValid(); ++mfi)
+        {
+            const auto it = permutations.find(std::make_pair(mfi.index(), mfi.LocalTileIndex()));
+            if (it == permutations.end()) { continue; }
+            ReorderParticles(lev, mfi, it->second.dataPtr());
+        }
+    }
+
+    return num_sorted;
+}
@@ -0,0 +1,108 @@
+/* Copyright 2025 The WarpX Community
+ *
+ * This file is part of WarpX.
+ *
+ * License: BSD-3-Clause-LBNL
+ */
+#include "CellIndex.H"
+
+#include "Particles/WarpXParticleContainer.H"
+#include "Utils/WarpXProfilerWrapper.H"
+
+#include <AMReX_Box.H>
+#include <AMReX_DenseBins.H>
+#include <AMReX_Geometry.H>
+#include <AMReX_GpuQualifiers.H>
+#include <AMReX_IntVect.H>
+#include <AMReX_MFIter.H>
+#include <AMReX_ParticleUtil.H>
+
+SetParticleCellIndex::SetParticleCellIndex (const WarpXParIter& a_pti,
+                                            const WarpXParticleContainer& a_pc,
+                                            long a_offset) noexcept
+{
+    if (!a_pc.CacheCellIndex()) { return; }
+    m_is_noop = false;
+
+    const amrex::Geometry& geom = a_pc.Geom(a_pti.GetLevel());
+    m_plo = geom.ProbLoArray();
+    m_dxi = geom.InvCellSizeArray();
+
+    auto& soa = a_pti.GetStructOfArrays();
+    for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+        m_cell[idim] = soa.GetIntData(CellIndexCompNames()[idim]).dataPtr() + a_offset;
+        m_domain_lo[idim] = geom.Domain().smallEnd(idim);
+    }
+}
+
+GetParticleCellIndex::GetParticleCellIndex (const WarpXParticleContainer& a_pc, int a_lev) noexcept
+{
+    if (!a_pc.HasValidCellIndex(a_lev)) { return; }
+    m_is_noop = false;
+
+    const amrex::Geometry& geom = a_pc.Geom(a_lev);
+    for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+        m_comp[idim] = a_pc.GetIntCompIndex(CellIndexCompNames()[idim]);
+        m_domain_lo[idim] = geom.Domain().smallEnd(idim);
+        m_domain_length[idim] = geom.Domain().length(idim);
+        m_wrap[idim] = (a_pc.CellIndexRedistributed() && geom.isPeriodic(idim)) ? 1 : 0;
+    }
+}
+
+bool
+WarpXParticleContainer::HasValidCellIndex (int lev) const
+{
+    // The cached index is relative to the lower corner of the domain at the time
+    // of the push, which moves with the moving window and the Galilean shift
+    return m_cache_cell_index && m_cell_index_valid &&
+        lev == 0 && finestLevel() == 0 &&
+        amrex::RealVect(Geom(0).ProbLo()) == m_cell_index_plo;
+}
+
+void
+WarpXParticleContainer::ValidateCellIndex ()
+{
+    m_cell_index_valid = true;
+    m_cell_index_redistributed = false;
+    m_cell_index_plo = amrex::RealVect(Geom(0).ProbLo());
+}
+
+/* \brief Same as amrex::ParticleContainer::SortParticlesByBin, but reads the
+ *        cached cell index instead of computing it from the particle positions.
+ *        Must only be called when HasValidCellIndex is true.
+ */
+void
+WarpXParticleContainer::SortParticlesByCellIndex (amrex::IntVect bin_size)
+{
+    WARPX_PROFILE("WarpXParticleContainer::SortParticlesByCellIndex");
+
+    if (bin_size == amrex::IntVect::TheZeroVector()) { return; }
+
+    for (int lev = 0; lev <= finestLevel(); ++lev)
+    {
+        const auto get_cell_index = GetParticleCellIndex(*this, lev);
+        AMREX_ALWAYS_ASSERT(!get_cell_index.isNoOp());
+
+        for (amrex::MFIter mfi = MakeMFIter(lev); mfi.isValid(); ++mfi)
+        {
+            auto& ptile = ParticlesAt(lev, mfi);
+            const auto np = ptile.numParticles();
+            if (np == 0) { continue; }
+
+            const amrex::Box box = mfi.validbox();
+            const int ntiles = amrex::numTilesInBox(box, true, bin_size);
+
+            amrex::DenseBins<ParticleTileType::ParticleTileDataType> bins;
+            bins.build(np, ptile.getParticleTileData(), ntiles,
+                [=] AMREX_GPU_HOST_DEVICE (const ParticleType& p) -> unsigned int
+                {
+                    amrex::Box tbox;
+                    const amrex::IntVect iv = get_cell_index(p, box);
+                    return static_cast<unsigned int>(
+                        amrex::getTileIndex(iv, box, true, bin_size, tbox));
+                });
+
+            ReorderParticles(lev, mfi, bins.permutationPtr());
+        }
+    }
+}
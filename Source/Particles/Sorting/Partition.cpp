@@ -148,3 +148,64 @@ PhysicalParticleContainer::PartitionParticlesInBuffers(
     // the GPU kernels finish running
     Gpu::streamSynchronize();
 }
+
+/* \brief Reorder the particle arrays of a tile so that the particles whose field
+ *        gather only reads the valid cells of the grid come first
+ *
+ *  These particles can be pushed before the guard cells of the fields are filled,
+ *  while the guard cell exchange is in flight (see WarpX::overlap_guard_cell_exchange).
+ *
+ * \param np total number of particles in this tile
+ * \param pti object that holds the particle information for this tile
+ * \param lev current refinement level
+ * \return number of particles in the interior, i.e. at the beginning of the tile
+ */
+long
+PhysicalParticleContainer::PartitionParticlesInInterior(
+    long const np, WarpXParIter& pti, int const lev )
+{
+    WARPX_PROFILE("PhysicalParticleContainer::PartitionParticlesInInterior");
+
+    // Cells in which the stencil of the field gather does not reach the guard cells
+    const Box interior_box = amrex::grow(ParticleBoxArray(lev)[pti.index()],
+                                         -WarpX::GetInstance().get_ng_fieldgather());
+    if (interior_box.isEmpty()) { return 0; }
+
+    // Initialize temporary arrays
+    Gpu::DeviceVector<int> inexflag;
+    inexflag.resize(np);
+    Gpu::DeviceVector<int> pid;
+    pid.resize(np);
+
+    // - For each particle, find whether it is in the boundary layer of the grid.
+    //   Store the answer in `inexflag`.
+    amrex::ParallelFor( np, fillBoundaryLayerFlag(pti, interior_box, inexflag, Geom(lev)) );
+    // - Find the indices that reorder particles so that the last particles
+    //   are in the boundary layer
+    fillWithConsecutiveIntegers( pid );
+    auto *const sep = stablePartition( pid.begin(), pid.end(), inexflag );
+    long const n_interior = iteratorDistance(pid.begin(), sep);
+
+    // Reorder the actual particle array, using the `pid` indices
+    if (n_interior != np && n_interior != 0)
+    {
+        // Prepare temporary particle tile to copy to
+        ParticleTileType ptile_tmp;
+        ptile_tmp.define(NumRuntimeRealComps(), NumRuntimeIntComps());
+        ptile_tmp.resize(np);
+
+        // Copy and re-order the data of the current particle tile
+        ParticleTileType& ptile = pti.GetParticleTile();
+        amrex::gatherParticles(ptile_tmp, ptile, np, pid.dataPtr());
+        ptile.swap(ptile_tmp);
+
+        // Make sure that the temporary particle tile is not destroyed before
+        // the GPU kernels finish running
+        Gpu::streamSynchronize();
+    }
+    // Make sure that the temporary arrays are not destroyed before
+    // the GPU kernels finish running
+    Gpu::streamSynchronize();
+
+    return n_interior;
+}
@@ -13,11 +13,14 @@
 #include "Deposition/ChargeDeposition.H"
 #include "Deposition/CurrentDeposition.H"
 #include "Deposition/SharedDepositionUtils.H"
+#include "Deposition/VectorizedCurrentDeposition.H"
 #include "EmbeddedBoundary/Enabled.H"
 #include "Fields.H"
+#include "Parallelization/CostTimer.H"
 #include "Pusher/GetAndSetPosition.H"
 #include "Pusher/UpdatePosition.H"
 #include "ParticleBoundaries_K.H"
+#include "Sorting/CellIndex.H"
 #include "Utils/TextMsg.H"
 #include "Utils/WarpXAlgorithmSelection.H"
 #include "Utils/WarpXConst.H"
@@ -185,6 +188,9 @@ WarpXParticleContainer::AddNParticles (int /*lev*/, long n,
     WARPX_ALWAYS_ASSERT_WITH_MESSAGE(nattr_int <= NumIntComps(),
                                      "Too many integer attributes specified");
 
+    // The new particles do not have a cell index yet
+    InvalidateCellIndex();
+
     long ibegin = 0;
     long iend = n;
     if (!uniqueparticles) {
@@ -352,6 +358,9 @@ WarpXParticleContainer::deleteInvalidParticles () {
  *                       current positions of the particles. When different than 0,
  *                       the particle position will be temporarily modified to match
  *                       the time of the deposition.
+ * \param push_type   Type of particle push (explicit or implicit)
+ * \param old_shapes  Shape factors at the old particle positions, stored by the field gather
+ *                    (only used by the explicit Esirkepov deposition, if not a no-op)
  */
 void
 WarpXParticleContainer::DepositCurrent (WarpXParIter& pti,
@@ -361,7 +370,8 @@ WarpXParticleContainer::DepositCurrent (WarpXParIter& pti,
                                         amrex::MultiFab * const jx, amrex::MultiFab * const jy, amrex::MultiFab * const jz,
                                         long const offset, long const np_to_deposit,
                                         int const thread_num, const int lev, int const depos_lev,
-                                        amrex::Real const dt, amrex::Real const relative_time, PushType push_type)
+                                        amrex::Real const dt, amrex::Real const relative_time, PushType push_type,
+                                        NodeShapeFactorsArray const& old_shapes)
 {
     WARPX_ALWAYS_ASSERT_WITH_MESSAGE((depos_lev==(lev-1)) ||
                                      (depos_lev==(lev  )),
@@ -595,7 +605,61 @@ WarpXParticleContainer::DepositCurrent (WarpXParIter& pti,
                     eb_reduce_particle_shape = (*warpx.GetEBReduceParticleShapeFlag()[lev])[pti].array();
                 }
 
-                if      (WarpX::nox == 1){
+                if (!old_shapes.isNoOp()) {
+                    WARPX_PROFILE_VAR_START(esirkepov_current_dep_kernel);
+                    if      (WarpX::nox == 1){
+                        doEsirkepovDepositionShapeNWithOldShape<1>(
+                            GetPosition, wp.dataPtr() + offset, uxp.dataPtr() + offset,
+                            uyp.dataPtr() + offset, uzp.dataPtr() + offset, ion_lev, old_shapes,
+                            jx_arr, jy_arr, jz_arr, np_to_deposit, dt, dinv, xyzmin, lo, q);
+                    } else if (WarpX::nox == 2){
+                        doEsirkepovDepositionShapeNWithOldShape<2>(
+                            GetPosition, wp.dataPtr() + offset, uxp.dataPtr() + offset,
+                            uyp.dataPtr() + offset, uzp.dataPtr() + offset, ion_lev, old_shapes,
+                            jx_arr, jy_arr, jz_arr, np_to_deposit, dt, dinv, xyzmin, lo, q);
+                    } else if (WarpX::nox == 3){
+                        doEsirkepovDepositionShapeNWithOldShape<3>(
+                            GetPosition, wp.dataPtr() + offset, uxp.dataPtr() + offset,
+                            uyp.dataPtr() + offset, uzp.dataPtr() + offset, ion_lev, old_shapes,
+                            jx_arr, jy_arr, jz_arr, np_to_deposit, dt, dinv, xyzmin, lo, q);
+                    } else if (WarpX::nox == 4){
+                        doEsirkepovDepositionShapeNWithOldShape<4>(
+                            GetPosition, wp.dataPtr() + offset, uxp.dataPtr() + offset,
+                            uyp.dataPtr() + offset, uzp.dataPtr() + offset, ion_lev, old_shapes,
+                            jx_arr, jy_arr, jz_arr, np_to_deposit, dt, dinv, xyzmin, lo, q);
+                    }
+                    WARPX_PROFILE_VAR_STOP(esirkepov_current_dep_kernel);
+                }
+                else if (WarpX::do_vectorized_current_deposition) {
+                    WARPX_PROFILE_VAR_START(esirkepov_current_dep_kernel);
+                    if      (WarpX::nox == 1){
+                        doEsirkepovDepositionShapeNVectorized<1>(
+                            GetPosition, wp.dataPtr() + offset, uxp.dataPtr() + offset,
+                            uyp.dataPtr() + offset, uzp.dataPtr() + offset, ion_lev,
+                            jx_arr, jy_arr, jz_arr,
+                            np_to_deposit, dt, relative_time, dinv, xyzmin, lo, q);
+                    } else if (WarpX::nox == 2){
+                        doEsirkepovDepositionShapeNVectorized<2>(
+                            GetPosition, wp.dataPtr() + offset, uxp.dataPtr() + offset,
+                            uyp.dataPtr() + offset, uzp.dataPtr() + offset, ion_lev,
+                            jx_arr, jy_arr, jz_arr,
+                            np_to_deposit, dt, relative_time, dinv, xyzmin, lo, q);
+                    } else if (WarpX::nox == 3){
+                        doEsirkepovDepositionShapeNVectorized<3>(
+                            GetPosition, wp.dataPtr() + offset, uxp.dataPtr() + offset,
+                            uyp.dataPtr() + offset, uzp.dataPtr() + offset, ion_lev,
+                            jx_arr, jy_arr, jz_arr,
+                            np_to_deposit, dt, relative_time, dinv, xyzmin, lo, q);
+                    } else if (WarpX::nox == 4){
+                        doEsirkepovDepositionShapeNVectorized<4>(
+                            GetPosition, wp.dataPtr() + offset, uxp.dataPtr() + offset,
+                            uyp.dataPtr() + offset, uzp.dataPtr() + offset, ion_lev,
+                            jx_arr, jy_arr, jz_arr,
+                            np_to_deposit, dt, relative_time, dinv, xyzmin, lo, q);
+                    }
+                    WARPX_PROFILE_VAR_STOP(esirkepov_current_dep_kernel);
+                }
+                else if (WarpX::nox == 1){
                     doEsirkepovDepositionShapeN<1>(
                     GetPosition, wp.dataPtr() + offset, uxp.dataPtr() + offset,
                     uyp.dataPtr() + offset, uzp.dataPtr() + offset, ion_lev,
@@ -767,7 +831,35 @@ WarpXParticleContainer::DepositCurrent (WarpXParIter& pti,
                         WarpX::n_rz_azimuthal_modes);
             }
         } else { // Direct deposition
-            if (push_type == PushType::Explicit) {
+            if (push_type == PushType::Explicit && WarpX::do_cell_blocked_current_deposition) {
+                WARPX_PROFILE_VAR_START(direct_current_dep_kernel);
+                if        (WarpX::nox == 1){
+                    doDepositionShapeNCellBlocked<1>(
+                        GetPosition, wp.dataPtr() + offset, uxp.dataPtr() + offset,
+                        uyp.dataPtr() + offset, uzp.dataPtr() + offset, ion_lev,
+                        jx_fab, jy_fab, jz_fab, np_to_deposit, relative_time, dinv,
+                        xyzmin, lo, q, WarpX::n_rz_azimuthal_modes);
+                } else if (WarpX::nox == 2){
+                    doDepositionShapeNCellBlocked<2>(
+                        GetPosition, wp.dataPtr() + offset, uxp.dataPtr() + offset,
+                        uyp.dataPtr() + offset, uzp.dataPtr() + offset, ion_lev,
+                        jx_fab, jy_fab, jz_fab, np_to_deposit, relative_time, dinv,
+                        xyzmin, lo, q, WarpX::n_rz_azimuthal_modes);
+                } else if (WarpX::nox == 3){
+                    doDepositionShapeNCellBlocked<3>(
+                        GetPosition, wp.dataPtr() + offset, uxp.dataPtr() + offset,
+                        uyp.dataPtr() + offset, uzp.dataPtr() + offset, ion_lev,
+                        jx_fab, jy_fab, jz_fab, np_to_deposit, relative_time, dinv,
+                        xyzmin, lo, q, WarpX::n_rz_azimuthal_modes);
+                } else if (WarpX::nox == 4){
+                    doDepositionShapeNCellBlocked<4>(
+                        GetPosition, wp.dataPtr() + offset, uxp.dataPtr() + offset,
+                        uyp.dataPtr() + offset, uzp.dataPtr() + offset, ion_lev,
+                        jx_fab, jy_fab, jz_fab, np_to_deposit, relative_time, dinv,
+                        xyzmin, lo, q, WarpX::n_rz_azimuthal_modes);
+                }
+                WARPX_PROFILE_VAR_STOP(direct_current_dep_kernel);
+            } else if (push_type == PushType::Explicit) {
                 if        (WarpX::nox == 1){
                     doDepositionShapeN<1>(
                         GetPosition, wp.dataPtr() + offset, uxp.dataPtr() + offset,
@@ -1496,7 +1588,8 @@ WarpXParticleContainer::PushX (int lev, amrex::Real dt)
 
     if (do_not_push) { return; }
 
-    amrex::LayoutData<amrex::Real>* costs = WarpX::getCosts(lev);
+    // This push does not update the cached cell index
+    InvalidateCellIndex();
 
 #ifdef AMREX_USE_OMP
 #pragma omp parallel if (amrex::Gpu::notInLaunchRegion())
@@ -1505,11 +1598,7 @@ WarpXParticleContainer::PushX (int lev, amrex::Real dt)
 
         for (WarpXParIter pti(*this, lev); pti.isValid(); ++pti)
         {
-            if (costs && WarpX::load_balance_costs_update_algo == LoadBalanceCostsUpdateAlgo::Timers)
-            {
-                amrex::Gpu::synchronize();
-            }
-            auto wt = static_cast<amrex::Real>(amrex::second());
+            CostTimer cost_timer(lev, pti.index());
 
             //
             // Particle Push
@@ -1534,12 +1623,7 @@ WarpXParticleContainer::PushX (int lev, amrex::Real dt)
                 }
             );
 
-            if (costs && WarpX::load_balance_costs_update_algo == LoadBalanceCostsUpdateAlgo::Timers)
-            {
-                amrex::Gpu::synchronize();
-                wt = static_cast<amrex::Real>(amrex::second()) - wt;
-                amrex::HostDevice::Atomic::Add( &(*costs)[pti.index()], wt);
-            }
+            cost_timer.record(KernelCost::GatherPush);
         }
     }
 }
@@ -1615,6 +1699,7 @@ WarpXParticleContainer::ApplyBoundaryConditions (){
         {
             auto GetPosition = GetParticlePosition<PIdx>(pti);
             auto SetPosition = SetParticlePosition<PIdx>(pti);
+            const auto SetCellIndex = SetParticleCellIndex(pti, *this);
             amrex::XDim3 gridmin;
             amrex::XDim3 gridmax;
 #ifndef WARPX_DIM_1D_Z
@@ -1657,6 +1742,9 @@ WarpXParticleContainer::ApplyBoundaryConditions (){
                         pidw.make_invalid();
                     } else {
                         SetPosition.AsStored(i, x, y, z);
+                        if (!SetCellIndex.isNoOp()) {
+                            SetCellIndex.AsStored(i, x, y, z);
+                        }
                     }
                 }
             );
@@ -39,7 +39,8 @@ namespace ParticleUtils
     ParticleBins
     findParticlesInEachCell (int lev,
                              MFIter const & mfi,
-                             ParticleTileType & ptile) {
+                             ParticleTileType & ptile,
+                             GetParticleCellIndex const & get_cell_index) {
 
         // Extract particle structures for this tile
         int const np = ptile.numParticles();
@@ -55,6 +56,14 @@ namespace ParticleUtils
         // Find particles that are in each cell;
         // results are stored in the object `bins`.
         ParticleBins bins;
+        if (!get_cell_index.isNoOp()) {
+            bins.build(np, ptd, cbx,
+                [=] AMREX_GPU_DEVICE (ParticleType const & p) noexcept -> amrex::IntVect
+                {
+                    return get_cell_index(p, cbx) - cbx.smallEnd();
+                });
+            return bins;
+        }
         bins.build(np, ptd, cbx,
             // Pass lambda function that returns the cell index
             [=] AMREX_GPU_DEVICE (ParticleType const & p) noexcept -> amrex::IntVect
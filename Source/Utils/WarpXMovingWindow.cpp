@@ -17,6 +17,7 @@
 #include "Fields.H"
 #include "Fluids/MultiFluidContainer.H"
 #include "Fluids/WarpXFluidContainer.H"
+#include "Parallelization/CostTimer.H"
 #include "Utils/TextMsg.H"
 #include "Utils/WarpXConst.H"
 #include "Utils/WarpXProfilerWrapper.H"
@@ -68,7 +69,7 @@ namespace
     * \param[in] dir direction of the shift
     * \param[in] safe_guard_cells flag to enable "safe mode" data exchanges with more guard cells
     * \param[in] do_single_precision_comms flag to enable single precision communications
-    * \param[in,out] cost the pointer to the data structure holding costs for timer-based load-balance
+    * \param[in] cost_lev level of the costs for timer-based load-balance (-1 to not update the costs)
     * \param[in] external_field the external field (used to initialize EM fields)
     * \param[in] useparser flag to enable the use of a field parser to initialize EM fields
     * \param[in] field_parser the field parser
@@ -78,7 +79,7 @@ namespace
         amrex::MultiFab& mf, const amrex::Geometry& geom,
         int num_shift, int dir,
         bool safe_guard_cells, bool do_single_precision_comms,
-        amrex::LayoutData<amrex::Real>* cost,
+        int cost_lev,
         amrex::Real external_field=0.0, bool useparser = false,
         amrex::ParserExecutor<3> const& field_parser={},
         const bool PMLRZ_flag = false)
@@ -144,11 +145,7 @@ namespace
 #endif
         for (amrex::MFIter mfi(tmpmf, TilingIfNotGPU()); mfi.isValid(); ++mfi )
         {
-            if (cost)
-            {
-                amrex::Gpu::synchronize();
-            }
-            auto wt = static_cast<amrex::Real>(amrex::second());
+            CostTimer cost_timer(cost_lev, mfi.index());
 
             auto const& dstfab = mf.array(mfi);
             auto const& srcfab = tmpmf.array(mfi);
@@ -209,12 +206,7 @@ namespace
                 dstfab(i,j,k,n) = srcfab(i+shift.x,j+shift.y,k+shift.z,n);
             })
 
-            if (cost)
-            {
-                amrex::Gpu::synchronize();
-                wt = static_cast<amrex::Real>(amrex::second()) - wt;
-                amrex::HostDevice::Atomic::Add( &(*cost)[mfi.index()], wt);
-            }
+            cost_timer.record(KernelCost::FieldSolve);
         }
 
 #if (defined WARPX_DIM_RZ) && (defined WARPX_USE_FFT)
@@ -409,10 +401,9 @@ WarpX::MoveWindow (const int step, bool move_j)
             num_shift *= refRatio(lev-1)[dir];
         }
 
-        auto* cost_lev =
-            (WarpX::load_balance_costs_update_algo == LoadBalanceCostsUpdateAlgo::Timers) ? getCosts(lev)  : nullptr;
+        const int cost_lev = lev;
 
-        amrex::LayoutData<amrex::Real>* no_cost = nullptr ; //We can't update cost for PML
+        constexpr int no_cost = -1; //We can't update cost for PML
 
         // Shift each component of vector fields (E, B, j)
         for (int dim = 0; dim < 3; ++dim) {
@@ -732,5 +723,9 @@ WarpX::ResetProbDomain (const amrex::RealBox& rb)
         amrex::Geometry g = Geom(lev);
         g.ProbDomain(rb);
         SetGeometry(lev, g);
+        // The particles with their own boxes also have their own geometry
+        if (m_decouple_particle_layout && lev <= finest_level) {
+            mypc->SetParticleGeometry(lev, g);
+        }
     }
 }
@@ -123,6 +123,7 @@ bool WarpX::do_single_precision_comms = false;
 
 bool WarpX::do_shared_mem_charge_deposition = false;
 bool WarpX::do_shared_mem_current_deposition = false;
+bool WarpX::do_cell_blocked_current_deposition = false;
 #if defined(WARPX_DIM_3D)
 amrex::IntVect WarpX::shared_tilesize(AMREX_D_DECL(6,6,8));
 #elif (AMREX_SPACEDIM == 2)
@@ -371,7 +372,9 @@ WarpX::WarpX ()
     do_pml_Hi.resize(nlevs_max);
 
     costs.resize(nlevs_max);
+    kernel_costs.resize(nlevs_max);
     load_balance_efficiency.resize(nlevs_max);
+    load_balance_efficiency_achieved.resize(nlevs_max, -1);
 
     m_field_factory.resize(nlevs_max);
 
@@ -383,8 +386,10 @@ WarpX::WarpX ()
     // Set default values for particle and cell weights for costs update;
     // Default values listed here for the case AMREX_USE_GPU are determined
     // from single-GPU tests on Summit.
+    // (With calibration, these are only used if the fit fails.)
     if (costs_heuristic_cells_wt<=0. && costs_heuristic_particles_wt<=0.
-        && WarpX::load_balance_costs_update_algo==LoadBalanceCostsUpdateAlgo::Heuristic)
+        && (WarpX::load_balance_costs_update_algo==LoadBalanceCostsUpdateAlgo::Heuristic
+            || costs_heuristic_calibrate))
     {
 #ifdef AMREX_USE_GPU
         if (WarpX::electromagnetic_solver_id == ElectromagneticSolverAlgo::PSATD) {
@@ -786,6 +791,8 @@ WarpX::ReadParameters ()
                 ablastr::warn_manager::WarnPriority::low);
         }
 #endif
+        pp_warpx.query("overlap_guard_cell_exchange", m_overlap_guard_cell_exchange);
+        pp_warpx.query("do_task_graph", m_do_task_graph);
         pp_warpx.query("do_shared_mem_charge_deposition", do_shared_mem_charge_deposition);
         pp_warpx.query("do_shared_mem_current_deposition", do_shared_mem_current_deposition);
 #if !(defined(AMREX_USE_HIP) || defined(AMREX_USE_CUDA))
@@ -793,6 +800,11 @@ WarpX::ReadParameters ()
                 "requested shared memory for current deposition, but shared memory is only available for CUDA or HIP");
 #endif
         pp_warpx.query("shared_mem_current_tpb", shared_mem_current_tpb);
+        pp_warpx.query("do_cell_blocked_current_deposition", do_cell_blocked_current_deposition);
+#ifdef AMREX_USE_GPU
+        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(!do_cell_blocked_current_deposition,
+                "requested cell-blocked current deposition, but it is only available for CPU");
+#endif
 
         // initialize the shared tilesize
         Vector<int> vect_shared_tilesize(AMREX_SPACEDIM, 1);
@@ -1132,6 +1144,9 @@ WarpX::ReadParameters ()
             current_deposition_algo = CurrentDepositionAlgo::Direct;
         }
         pp_algo.query_enum_sloppy("current_deposition", current_deposition_algo, "-_");
+        pp_algo.query("vectorized_current_deposition", do_vectorized_current_deposition);
+        pp_algo.query("fused_push_deposit", do_fused_push_deposit);
+        pp_algo.query("reuse_gather_shape_factors", reuse_gather_shape_factors);
         pp_algo.query_enum_sloppy("charge_deposition", charge_deposition_algo, "-_");
         pp_algo.query_enum_sloppy("particle_pusher", particle_pusher_algo, "-_");
 
@@ -1187,6 +1202,65 @@ WarpX::ReadParameters ()
                 "Vay deposition not implemented with multi-J algorithm");
         }
 
+        if (do_cell_blocked_current_deposition) {
+            WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+                current_deposition_algo == CurrentDepositionAlgo::Direct &&
+                evolve_scheme == EvolveScheme::Explicit,
+                "warpx.do_cell_blocked_current_deposition is only implemented for the direct "
+                "current deposition with the explicit evolve scheme");
+        }
+
+        if (do_vectorized_current_deposition) {
+#if defined(AMREX_USE_GPU) || defined(WARPX_DIM_RZ)
+            WARPX_ABORT_WITH_MESSAGE(
+                "algo.vectorized_current_deposition is only available for CPU builds in Cartesian geometry");
+#endif
+            WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+                current_deposition_algo == CurrentDepositionAlgo::Esirkepov &&
+                evolve_scheme == EvolveScheme::Explicit,
+                "algo.vectorized_current_deposition is only implemented for the Esirkepov "
+                "current deposition with the explicit evolve scheme");
+            WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+                !EB::enabled(),
+                "algo.vectorized_current_deposition cannot be used with embedded boundaries");
+        }
+
+        if (do_fused_push_deposit) {
+#if defined(WARPX_DIM_RZ)
+            WARPX_ABORT_WITH_MESSAGE(
+                "algo.fused_push_deposit is only available in Cartesian geometry");
+#endif
+            WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+                current_deposition_algo == CurrentDepositionAlgo::Esirkepov &&
+                evolve_scheme == EvolveScheme::Explicit &&
+                electromagnetic_solver_id != ElectromagneticSolverAlgo::PSATD,
+                "algo.fused_push_deposit is only implemented for the Esirkepov "
+                "current deposition with the explicit evolve scheme and a finite-difference solver");
+            WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+                !EB::enabled() && !do_vectorized_current_deposition &&
+                !do_shared_mem_current_deposition,
+                "algo.fused_push_deposit cannot be used with embedded boundaries, "
+                "algo.vectorized_current_deposition or warpx.do_shared_mem_current_deposition");
+        }
+
+        if (reuse_gather_shape_factors) {
+#if defined(WARPX_DIM_RZ)
+            WARPX_ABORT_WITH_MESSAGE(
+                "algo.reuse_gather_shape_factors is only available in Cartesian geometry");
+#endif
+            WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+                current_deposition_algo == CurrentDepositionAlgo::Esirkepov &&
+                evolve_scheme == EvolveScheme::Explicit &&
+                electromagnetic_solver_id != ElectromagneticSolverAlgo::PSATD,
+                "algo.reuse_gather_shape_factors is only implemented for the Esirkepov "
+                "current deposition with the explicit evolve scheme and a finite-difference solver");
+            WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+                !EB::enabled() && !do_vectorized_current_deposition &&
+                !do_shared_mem_current_deposition,
+                "algo.reuse_gather_shape_factors cannot be used with embedded boundaries, "
+                "algo.vectorized_current_deposition or warpx.do_shared_mem_current_deposition");
+        }
+
         if (current_deposition_algo == CurrentDepositionAlgo::Villasenor) {
             WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
                 evolve_scheme == EvolveScheme::SemiImplicitEM ||
@@ -1261,6 +1335,48 @@ WarpX::ReadParameters ()
                                       macroscopic_solver_algo, "-_");
         }
 
+        utils::parser::queryWithParser(pp_algo, "fdtd_deep_halo_steps", m_fdtd_deep_halo_steps);
+        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(m_fdtd_deep_halo_steps >= 1,
+            "algo.fdtd_deep_halo_steps must be at least 1");
+        if (m_fdtd_deep_halo_steps > 1) {
+#ifdef WARPX_DIM_RZ
+            WARPX_ABORT_WITH_MESSAGE("algo.fdtd_deep_halo_steps > 1 is not available in RZ geometry");
+#endif
+            WARPX_ALWAYS_ASSERT_WITH_MESSAGE(!EB::enabled(),
+                "algo.fdtd_deep_halo_steps > 1 is not available with embedded boundaries");
+            WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+                evolve_scheme == EvolveScheme::Explicit &&
+                electrostatic_solver_id == ElectrostaticSolverAlgo::None &&
+                (electromagnetic_solver_id == ElectromagneticSolverAlgo::Yee ||
+                 electromagnetic_solver_id == ElectromagneticSolverAlgo::CKC),
+                "algo.fdtd_deep_halo_steps > 1 requires the explicit Yee or CKC solver");
+            WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+                maxLevel() == 0 && m_em_solver_medium == MediumForEM::Vacuum,
+                "algo.fdtd_deep_halo_steps > 1 requires a single level and a vacuum medium");
+            WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+                !do_multi_J && !do_dive_cleaning && !do_divb_cleaning && m_num_mirrors == 0 &&
+                !m_safe_guard_cells && !m_overlap_guard_cell_exchange,
+                "algo.fdtd_deep_halo_steps > 1 is not compatible with warpx.do_multi_J, "
+                "warpx.do_dive_cleaning, warpx.do_divb_cleaning, warpx.num_mirrors, "
+                "warpx.safe_guard_cells and warpx.overlap_guard_cell_exchange");
+            constexpr auto is_supported = [](const FieldBoundaryType fbt) {
+                return fbt == FieldBoundaryType::Periodic ||
+                       fbt == FieldBoundaryType::PEC ||
+                       fbt == FieldBoundaryType::PMC;
+            };
+            WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+                std::all_of(field_boundary_lo.begin(), field_boundary_lo.end(), is_supported) &&
+                std::all_of(field_boundary_hi.begin(), field_boundary_hi.end(), is_supported),
+                "algo.fdtd_deep_halo_steps > 1 requires periodic, pec or pmc field boundaries");
+        }
+
+        pp_algo.query("fdtd_temporal_blocking", m_fdtd_temporal_blocking);
+        utils::parser::queryWithParser(pp_algo, "fdtd_temporal_block_size", m_fdtd_temporal_block_size);
+        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(m_fdtd_temporal_block_size >= 1,
+            "algo.fdtd_temporal_block_size must be at least 1");
+
+        pp_algo.query("fdtd_fused_boundaries", m_fdtd_fused_boundaries);
+
         if (evolve_scheme == EvolveScheme::SemiImplicitEM ||
             evolve_scheme == EvolveScheme::ThetaImplicitEM ||
             evolve_scheme == EvolveScheme::StrangImplicitSpectralEM) {
@@ -1298,18 +1414,56 @@ WarpX::ReadParameters ()
         load_balance_intervals = utils::parser::IntervalsParser(
             load_balance_intervals_string_vec);
         pp_algo.query("load_balance_with_sfc", load_balance_with_sfc);
+        pp_algo.query("load_balance_with_diffusion", load_balance_with_diffusion);
+        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(!(load_balance_with_sfc && load_balance_with_diffusion),
+            "algo.load_balance_with_sfc and algo.load_balance_with_diffusion cannot be both used");
+        if (load_balance_with_diffusion) {
+            utils::parser::queryWithParser(
+                pp_algo, "load_balance_max_bytes_moved", load_balance_max_bytes_moved);
+        }
+        utils::parser::queryWithParser(
+            pp_algo, "load_balance_max_staging_bytes", load_balance_max_staging_bytes);
+        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(load_balance_max_staging_bytes > 0,
+            "algo.load_balance_max_staging_bytes must be positive");
         // Knapsack factor only used with non-SFC strategy
-        if (!load_balance_with_sfc) {
+        if (!load_balance_with_sfc && !load_balance_with_diffusion) {
             pp_algo.query("load_balance_knapsack_factor", load_balance_knapsack_factor);
         }
         utils::parser::queryWithParser(pp_algo, "load_balance_efficiency_ratio_threshold",
                         load_balance_efficiency_ratio_threshold);
         pp_algo.query_enum_sloppy("load_balance_costs_update", load_balance_costs_update_algo, "-_");
+        if (WarpX::load_balance_costs_update_algo==LoadBalanceCostsUpdateAlgo::CalibratedHeuristic) {
+            // The costs are measured with timers until the end of the calibration
+            costs_heuristic_calibrate = true;
+            WarpX::load_balance_costs_update_algo = LoadBalanceCostsUpdateAlgo::Timers;
+            utils::parser::queryWithParser(
+                pp_algo, "costs_heuristic_calibration_steps", costs_heuristic_calibration_steps);
+        }
+        pp_algo.query("decouple_particle_layout", m_decouple_particle_layout);
+        if (m_decouple_particle_layout) {
+            utils::parser::queryWithParser(pp_algo, "particle_max_grid_size", m_particle_max_grid_size);
+            WARPX_ALWAYS_ASSERT_WITH_MESSAGE(m_particle_max_grid_size >= 0,
+                "algo.particle_max_grid_size must be non-negative");
+            // The timers measure the cost of the particles on the boxes of the fields,
+            // which no longer hold the particles
+            if (WarpX::load_balance_costs_update_algo != LoadBalanceCostsUpdateAlgo::Heuristic) {
+                ablastr::warn_manager::WMRecordWarning("Load balancing",
+                    "With algo.decouple_particle_layout, the costs of the fields are always "
+                    "updated with the heuristic (algo.load_balance_costs_update = heuristic).",
+                    ablastr::warn_manager::WarnPriority::low);
+                WarpX::load_balance_costs_update_algo = LoadBalanceCostsUpdateAlgo::Heuristic;
+                costs_heuristic_calibrate = false;
+            }
+        }
         if (WarpX::load_balance_costs_update_algo==LoadBalanceCostsUpdateAlgo::Heuristic) {
             utils::parser::queryWithParser(
                 pp_algo, "costs_heuristic_cells_wt", costs_heuristic_cells_wt);
             utils::parser::queryWithParser(
                 pp_algo, "costs_heuristic_particles_wt", costs_heuristic_particles_wt);
+            std::vector<amrex::Real> species_wt;
+            utils::parser::queryArrWithParser(
+                pp_algo, "costs_heuristic_species_wt", species_wt);
+            costs_heuristic_species_wt.assign(species_wt.begin(), species_wt.end());
         }
 
         // Parse algo.particle_shape and check that input is acceptable
@@ -1397,6 +1551,16 @@ WarpX::ReadParameters ()
             }
         }
 
+        utils::parser::queryWithParser(pp_warpx, "sort_disorder_threshold", sort_disorder_threshold);
+        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+            sort_disorder_threshold < 0 || !sort_particles_for_deposition,
+            "warpx.sort_disorder_threshold requires warpx.sort_particles_for_deposition = 0");
+
+        pp_warpx.query("cache_particle_cell_index", cache_particle_cell_index);
+        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+            !cache_particle_cell_index || maxLevel() == 0,
+            "warpx.cache_particle_cell_index is not implemented with mesh refinement");
+
     }
 
     {
@@ -2030,7 +2194,9 @@ WarpX::ClearLevel (int lev)
 #endif
 
     costs[lev].reset();
+    kernel_costs[lev].reset();
     load_balance_efficiency[lev] = -1;
+    load_balance_efficiency_achieved[lev] = -1;
 }
 
 void
@@ -2070,7 +2236,8 @@ WarpX::AllocLevelData (int lev, const BoxArray& ba, const DistributionMapping& d
         WarpX::pml_ncell,
         this->refRatio(),
         use_filter,
-        bilinear_filter.stencil_length_each_dir);
+        bilinear_filter.stencil_length_each_dir,
+        m_fdtd_deep_halo_steps);
 
 #ifdef AMREX_USE_EB
     bool const eb_enabled = EB::enabled();
@@ -2238,6 +2405,14 @@ WarpX::AllocLevelMFs (int lev, const BoxArray& ba, const DistributionMapping& dm
         m_fields.alloc_init(FieldType::current_fp_nodal, Direction{2}, lev, nodal_ba, dm, ncomps, ngJ, 0.0_rt);
     }
 
+    // Current of the species that push while the current of the first species is summed
+    if (m_do_task_graph && maxLevel() == 0)
+    {
+        m_fields.alloc_init(FieldType::current_fp_stage, Direction{0}, lev, amrex::convert(ba, jx_nodal_flag), dm, ncomps, ngJ, 0.0_rt);
+        m_fields.alloc_init(FieldType::current_fp_stage, Direction{1}, lev, amrex::convert(ba, jy_nodal_flag), dm, ncomps, ngJ, 0.0_rt);
+        m_fields.alloc_init(FieldType::current_fp_stage, Direction{2}, lev, amrex::convert(ba, jz_nodal_flag), dm, ncomps, ngJ, 0.0_rt);
+    }
+
     if (WarpX::current_deposition_algo == CurrentDepositionAlgo::Vay)
     {
         m_fields.alloc_init(FieldType::current_fp_vay, Direction{0}, lev, amrex::convert(ba, rho_nodal_flag), dm, ncomps, ngJ, 0.0_rt);
@@ -2780,6 +2955,10 @@ WarpX::AllocLevelMFs (int lev, const BoxArray& ba, const DistributionMapping& dm
     if (load_balance_intervals.isActivated())
     {
         costs[lev] = std::make_unique<LayoutData<Real>>(ba, dm);
+        kernel_costs[lev] = std::make_unique<LayoutData<KernelCosts>>(ba, dm);
+        for (const auto& i : kernel_costs[lev]->IndexArray()) {
+            (*kernel_costs[lev])[i].fill(0.0_rt);
+        }
         load_balance_efficiency[lev] = -1;
     }
 }
@@ -3094,6 +3273,18 @@ WarpX::getCosts (int lev)
     }
 }
 
+amrex::LayoutData<KernelCosts>*
+WarpX::getKernelCosts (int lev)
+{
+    if (m_instance)
+    {
+        return m_instance->kernel_costs[lev].get();
+    } else
+    {
+        return nullptr;
+    }
+}
+
 void
 WarpX::setLoadBalanceEfficiency (const int lev, const amrex::Real efficiency)
 {
@@ -3118,6 +3309,18 @@ WarpX::getLoadBalanceEfficiency (const int lev)
     }
 }
 
+amrex::Real
+WarpX::getLoadBalanceEfficiencyAchieved (const int lev)
+{
+    if (m_instance)
+    {
+        return m_instance->load_balance_efficiency_achieved[lev];
+    } else
+    {
+        return -1;
+    }
+}
+
 void
 WarpX::BuildBufferMasks ()
 {
@@ -28,6 +28,21 @@
 #include <AMReX_ParmParse.H>
 #include <AMReX_REAL.H>
 
+#include <array>
+#include <memory>
+
+namespace
+{
+    /** Parameters on which the OpenBCSolver and its transformed Green's function depend */
+    struct IGFKey
+    {
+        amrex::Box domain;
+        std::array<amrex::Real, 3> cell_size{};
+        bool is_igf_2d_slices = false;
+        int nprocs = 0;
+    };
+}
+
 namespace ablastr::fields {
 
 void
@@ -53,17 +68,41 @@ computePhiIGF ( amrex::MultiFab const & rho,
         nprocs = std::max(1,std::min(nprocs, amrex::ParallelDescriptor::NProcs()));
     }
 
+    // The solver and its transformed Green's function are kept between calls, and are
+    // only computed again when the domain (e.g. after a regrid or a shift of the moving
+    // window), the cell size or the solver mode changed
     static std::unique_ptr<amrex::FFT::OpenBCSolver<amrex::Real>> obc_solver;
+    static IGFKey obc_solver_key;
     if (!obc_solver) {
         amrex::ExecOnFinalize([&] () { obc_solver.reset(); });
     }
-    if (!obc_solver || obc_solver->Domain() != domain) {
+    bool const new_solver = !obc_solver || obc_solver_key.domain != domain ||
+        obc_solver_key.is_igf_2d_slices != is_igf_2d_slices || obc_solver_key.nprocs != nprocs;
+    if (new_solver) {
         amrex::FFT::Info info{};
         if (is_igf_2d_slices) { info.setTwoDMode(true); } // do 2D FFTs
         info.setNumProcs(nprocs);
         obc_solver = std::make_unique<amrex::FFT::OpenBCSolver<amrex::Real>>(domain, info);
     }
 
+    if (new_solver || obc_solver_key.cell_size != cell_size) {
+        setIGFGreensFunction(*obc_solver, domain, cell_size, is_igf_2d_slices);
+        obc_solver_key = IGFKey{domain, cell_size, is_igf_2d_slices, nprocs};
+    }
+
+    obc_solver->solve(phi, rho);
+} // computePhiIGF
+
+void
+setIGFGreensFunction (amrex::FFT::OpenBCSolver<amrex::Real>& obc_solver,
+                      amrex::Box const & domain,
+                      std::array<amrex::Real, 3> const & cell_size,
+                      bool const is_igf_2d_slices)
+{
+    using namespace amrex::literals;
+
+    BL_PROFILE("ablastr::fields::setIGFGreensFunction");
+
     auto const& lo = domain.smallEnd();
     amrex::Real const dx = cell_size[0];
     amrex::Real const dy = cell_size[1];
@@ -71,7 +110,7 @@ computePhiIGF ( amrex::MultiFab const & rho,
 
     if (!is_igf_2d_slices){
         // fully 3D solver
-        obc_solver->setGreensFunction(
+        obc_solver.setGreensFunction(
         [=] AMREX_GPU_DEVICE (int i, int j, int k) -> amrex::Real
         {
             int const i0 = i - lo[0];
@@ -85,7 +124,7 @@ computePhiIGF ( amrex::MultiFab const & rho,
         });
     }else{
         // 2D sliced solver
-        obc_solver->setGreensFunction(
+        obc_solver.setGreensFunction(
         [=] AMREX_GPU_DEVICE (int i, int j, int k) -> amrex::Real
         {
             int const i0 = i - lo[0];
@@ -98,8 +137,6 @@ computePhiIGF ( amrex::MultiFab const & rho,
         });
 
     }
-
-    obc_solver->solve(phi, rho);
-} // computePhiIGF
+} // setIGFGreensFunction
 
 } // namespace ablastr::fields
@@ -7,8 +7,15 @@
  */
 #include "MultiFabRegister.H"
 
+#include <AMReX_Arena.H>
+#include <AMReX_FArrayBox.H>
+#include <AMReX_GpuDevice.H>
 #include <AMReX_MakeType.H>
+#include <AMReX_ParallelContext.H>
+#include <AMReX_ParallelDescriptor.H>
+#include <AMReX_Vector.H>
 
+#include <algorithm>
 #include <array>
 #include <memory>
 #include <optional>
@@ -18,6 +25,171 @@
 #include <vector>
 
 
+namespace
+{
+    /** Number of bytes of the data of a MultiFab on this MPI rank, including guard cells
+     *
+     * @param mf the MultiFab
+     * @return number of bytes
+     */
+    amrex::Long
+    local_bytes (amrex::MultiFab const & mf)
+    {
+        amrex::Long bytes = 0;
+        for (int const i : mf.IndexArray()) {
+            bytes += mf.fabbox(i).numPts() * mf.nComp() * static_cast<amrex::Long>(sizeof(amrex::Real));
+        }
+        return bytes;
+    }
+
+    /** Move a MultiFab to a new distribution mapping, one box at a time
+     *
+     * The boxes that stay on this MPI rank are moved without copy. The other boxes are sent to
+     * their new owner in batches, through staging buffers of at most max_staging_bytes (but at
+     * least one box) per MPI rank, and the old box is freed as soon as it is staged.
+     * Thus, the memory used on top of the steady state is bounded by the staging buffers,
+     * instead of a second copy of the MultiFab.
+     *
+     * @param mf the MultiFab to remake
+     * @param new_dm new distribution mapping
+     * @param redistribute copy the data to the new MultiFab (otherwise, it is not initialized)
+     * @param max_staging_bytes maximum number of bytes of the staging buffers
+     * @param[in,out] live_bytes number of bytes currently allocated on this MPI rank
+     * @param[in,out] peak_bytes peak of live_bytes
+     */
+    void
+    remake_multifab (
+        amrex::MultiFab & mf,
+        amrex::DistributionMapping const & new_dm,
+        bool redistribute,
+        amrex::Long max_staging_bytes,
+        amrex::Long & live_bytes,
+        amrex::Long & peak_bytes
+    )
+    {
+        amrex::BoxArray const ba = mf.boxArray();
+        amrex::DistributionMapping const old_dm = mf.DistributionMap();
+        int const ncomp = mf.nComp();
+        amrex::Arena * const arena = mf.arena();
+
+        // the boxes are allocated one by one below
+        const auto info = amrex::MFInfo().SetTag(mf.tags()[0]).SetArena(arena).SetAlloc(false);
+        amrex::MultiFab new_mf(ba, new_dm, ncomp, mf.nGrowVect(), info);
+
+        auto const fab_bytes = [&] (int i) {
+            return mf.fabbox(i).numPts() * ncomp * static_cast<amrex::Long>(sizeof(amrex::Real));
+        };
+        auto const alloc_fab = [&] (int i) {
+            live_bytes += fab_bytes(i);
+            peak_bytes = std::max(peak_bytes, live_bytes);
+            return std::make_unique<amrex::FArrayBox>(new_mf.fabbox(i), ncomp, arena);
+        };
+        auto const free_fab = [&] (int i) {
+            live_bytes -= fab_bytes(i);
+            std::unique_ptr<amrex::FArrayBox>(mf.release(i)).reset();
+        };
+
+        if (!redistribute) {
+            // free the old data before allocating the new one
+            for (int const i : amrex::Vector<int>(mf.IndexArray())) { free_fab(i); }
+            for (int const i : new_mf.IndexArray()) { new_mf.setFab(i, alloc_fab(i)); }
+            mf = std::move(new_mf);
+            return;
+        }
+
+        int const myproc = amrex::ParallelContext::MyProcSub();
+        int const nboxes = static_cast<int>(ba.size());
+        amrex::Vector<amrex::Long> rank_bytes(amrex::ParallelContext::NProcsSub(), 0);
+        int ibegin = 0;
+        while (ibegin < nboxes)
+        {
+            // The batch [ibegin, iend) is the same on all MPI ranks: each rank knows the
+            // staging bytes of all ranks from the distribution mappings
+            int iend = ibegin;
+            while (iend < nboxes) {
+                int const src = old_dm[iend];
+                int const dst = new_dm[iend];
+                if (src != dst) {
+                    amrex::Long const b = fab_bytes(iend);
+                    if (iend > ibegin && std::max(rank_bytes[src], rank_bytes[dst]) + b > max_staging_bytes) {
+                        break;
+                    }
+                    rank_bytes[src] += b;
+                    rank_bytes[dst] += b;
+                }
+                ++iend;
+            }
+            for (int i = ibegin; i < iend; ++i) {
+                rank_bytes[old_dm[i]] = 0;
+                rank_bytes[new_dm[i]] = 0;
+            }
+
+            amrex::Vector<int> recv_boxes;
+            amrex::Vector<int> send_boxes;
+            amrex::Long staging_bytes = 0;
+            for (int i = ibegin; i < iend; ++i) {
+                if (old_dm[i] == myproc && new_dm[i] == myproc) {
+                    // stays on this MPI rank: no copy
+                    new_mf.setFab(i, std::unique_ptr<amrex::FArrayBox>(mf.release(i)));
+                } else if (new_dm[i] == myproc) {
+                    recv_boxes.push_back(i);
+                    staging_bytes += fab_bytes(i);
+                } else if (old_dm[i] == myproc) {
+                    send_boxes.push_back(i);
+                    staging_bytes += fab_bytes(i);
+                }
+            }
+            ibegin = iend;
+
+#ifdef AMREX_USE_MPI
+            // SeqNum is collective: call it on all ranks for every batch, including the
+            // ranks that do not send or receive anything in this batch, so that the tags
+            // of the next batches stay the same on all ranks
+            int const tag = amrex::ParallelDescriptor::SeqNum();
+#endif
+
+            if (staging_bytes == 0) { continue; }
+
+            auto * const staging = static_cast<amrex::Real*>(amrex::The_Pinned_Arena()->alloc(staging_bytes));
+            live_bytes += staging_bytes;
+            peak_bytes = std::max(peak_bytes, live_bytes);
+
+#ifdef AMREX_USE_MPI
+            MPI_Comm const comm = amrex::ParallelContext::CommunicatorSub();
+            amrex::Vector<MPI_Request> reqs;
+            amrex::Real * ptr = staging;
+            for (int const i : recv_boxes) {
+                auto const n = static_cast<std::size_t>(mf.fabbox(i).numPts() * ncomp);
+                reqs.push_back(amrex::ParallelDescriptor::Arecv(ptr, n, old_dm[i], tag, comm).req());
+                ptr += n;
+            }
+            for (int const i : send_boxes) {
+                auto const n = static_cast<std::size_t>(mf.fabbox(i).numPts() * ncomp);
+                amrex::Gpu::dtoh_memcpy(ptr, mf[i].dataPtr(), fab_bytes(i));
+                free_fab(i);
+                reqs.push_back(amrex::ParallelDescriptor::Asend(ptr, n, new_dm[i], tag, comm).req());
+                ptr += n;
+            }
+            amrex::Vector<MPI_Status> stats(reqs.size());
+            amrex::ParallelDescriptor::Waitall(reqs, stats);
+
+            ptr = staging;
+            for (int const i : recv_boxes) {
+                auto fab = alloc_fab(i);
+                amrex::Gpu::htod_memcpy(fab->dataPtr(), ptr, fab_bytes(i));
+                new_mf.setFab(i, std::move(fab));
+                ptr += mf.fabbox(i).numPts() * ncomp;
+            }
+#endif
+
+            amrex::The_Pinned_Arena()->free(staging);
+            live_bytes -= staging_bytes;
+        }
+
+        mf = std::move(new_mf);
+    }
+}
+
 namespace ablastr::fields
 {
     amrex::MultiFab*
@@ -241,12 +413,23 @@ namespace ablastr::fields
         return &mf;
     }
 
-    void
+    amrex::Long
     MultiFabRegister::remake_level (
         int level,
-        amrex::DistributionMapping const & new_dm
+        amrex::DistributionMapping const & new_dm,
+        amrex::Long max_staging_bytes
     )
     {
+        // Bytes of all owning MultiFabs on this MPI rank, to track the peak memory
+        amrex::Long live_bytes = 0;
+        for (auto const & element : m_mf_register )
+        {
+            if (!element.second.is_alias()) {
+                live_bytes += local_bytes(element.second.m_mf);
+            }
+        }
+        amrex::Long peak_bytes = live_bytes;
+
         // Owning MultiFabs
         for (auto & element : m_mf_register )
         {
@@ -257,21 +440,12 @@ namespace ablastr::fields
                 continue;
             }
 
-            // remake MultiFab with new distribution map
+            // remake MultiFab with new distribution map, one box at a time
             if (mf_owner.m_level == level && !mf_owner.is_alias()) {
-                const amrex::MultiFab & mf = mf_owner.m_mf;
-                amrex::IntVect const & ng = mf.nGrowVect();
-                const auto tag = amrex::MFInfo().SetTag(mf.tags()[0]);
-                amrex::MultiFab new_mf(mf.boxArray(), new_dm, mf.nComp(), ng, tag);
-
                 // copy data to new MultiFab: Only done for persistent data like E and B field, not for
                 // temporary things like currents, etc.
-                if (mf_owner.m_redistribute_on_remake) {
-                    new_mf.Redistribute(mf, 0, 0, mf.nComp(), ng);
-                }
-
-                // replace old MultiFab with new one, deallocate old one
-                mf_owner.m_mf = std::move(new_mf);
+                remake_multifab(mf_owner.m_mf, new_dm, mf_owner.m_redistribute_on_remake,
+                                max_staging_bytes, live_bytes, peak_bytes);
             }
         }
 
@@ -295,6 +469,31 @@ namespace ablastr::fields
                 mf_owner.m_mf = std::move(new_mf);
             }
         }
+
+        return peak_bytes;
+    }
+
+    amrex::Long
+    MultiFabRegister::remake_bytes (
+        int level,
+        int box_index
+    ) const
+    {
+        amrex::Long bytes = 0;
+        for (auto const & element : m_mf_register )
+        {
+            MultiFabOwner const & mf_owner = element.second;
+
+            // same selection as the data copied in remake_level
+            if (mf_owner.m_remake && mf_owner.m_redistribute_on_remake &&
+                mf_owner.m_level == level && !mf_owner.is_alias())
+            {
+                const amrex::MultiFab & mf = mf_owner.m_mf;
+                bytes += mf.fabbox(box_index).numPts() * mf.nComp()
+                    * static_cast<amrex::Long>(sizeof(amrex::Real));
+            }
+        }
+        return bytes;
     }
 
     bool
@@ -114,6 +114,39 @@ void FillBoundary (amrex::MultiFab &mf,
     }
 }
 
+void FillBoundary_nowait (amrex::MultiFab &mf,
+                          amrex::IntVect ng,
+                          const amrex::Periodicity &period,
+                          std::optional<bool> nodal_sync)
+{
+    BL_PROFILE("ablastr::utils::communication::FillBoundary_nowait");
+
+    const amrex::ParmParse pp_ablastr("ablastr");
+    bool do_nodal_sync_input = false;
+    pp_ablastr.query("fillboundary_always_sync", do_nodal_sync_input);
+
+    if (nodal_sync.value_or(false) || do_nodal_sync_input) {
+        mf.FillBoundaryAndSync_nowait(0, mf.nComp(), ng, period);
+    } else {
+        mf.FillBoundary_nowait(0, mf.nComp(), ng, period);
+    }
+}
+
+void FillBoundary_finish (amrex::MultiFab &mf, std::optional<bool> nodal_sync)
+{
+    BL_PROFILE("ablastr::utils::communication::FillBoundary_finish");
+
+    const amrex::ParmParse pp_ablastr("ablastr");
+    bool do_nodal_sync_input = false;
+    pp_ablastr.query("fillboundary_always_sync", do_nodal_sync_input);
+
+    if (nodal_sync.value_or(false) || do_nodal_sync_input) {
+        mf.FillBoundaryAndSync_finish();
+    } else {
+        mf.FillBoundary_finish();
+    }
+}
+
 void FillBoundary (amrex::MultiFab &mf, bool do_single_precision_comms, const amrex::Periodicity &period, std::optional<bool> nodal_sync)
 {
     amrex::IntVect const ng = mf.n_grow;
@@ -174,6 +207,26 @@ SumBoundary (amrex::MultiFab &mf,
     }
 }
 
+void
+SumBoundary_nowait (amrex::MultiFab &mf,
+                    int start_comp,
+                    int num_comps,
+                    amrex::IntVect src_ng,
+                    amrex::IntVect dst_ng,
+                    const amrex::Periodicity &period)
+{
+    BL_PROFILE("ablastr::utils::communication::SumBoundary_nowait");
+
+    mf.SumBoundary_nowait(start_comp, num_comps, src_ng, dst_ng, period);
+}
+
+void SumBoundary_finish (amrex::MultiFab &mf)
+{
+    BL_PROFILE("ablastr::utils::communication::SumBoundary_finish");
+
+    mf.SumBoundary_finish();
+}
+
 void OverrideSync (amrex::MultiFab &mf,
                    bool do_single_precision_comms,
                    const amrex::Periodicity &period)
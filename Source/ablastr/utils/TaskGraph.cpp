@@ -0,0 +1,103 @@
+/* Copyright 2025 The WarpX Community
+ *
+ * This file is part of WarpX.
+ *
+ * License: BSD-3-Clause-LBNL
+ */
+#include "TaskGraph.H"
+
+#include "ablastr/profiler/ProfilerWrapper.H"
+#include "ablastr/utils/TextMsg.H"
+
+#include <algorithm>
+#include <cstddef>
+#include <deque>
+#include <utility>
+
+
+namespace ablastr::utils
+{
+
+TaskGraph::TaskId
+TaskGraph::addTask (std::string name, std::function<void()> run, std::vector<TaskId> deps)
+{
+    const auto id = static_cast<TaskId>(m_tasks.size());
+    // Tasks can only depend on tasks that were added before them: the graph has no cycle
+    ABLASTR_ALWAYS_ASSERT_WITH_MESSAGE(
+        std::all_of(deps.begin(), deps.end(), [id](TaskId d) { return d >= 0 && d < id; }),
+        "TaskGraph: a task can only depend on the tasks added before it");
+
+    Task task;
+    task.name = std::move(name);
+    task.run = std::move(run);
+    task.deps = std::move(deps);
+    m_tasks.push_back(std::move(task));
+    return id;
+}
+
+TaskGraph::TaskId
+TaskGraph::addCommTask (std::string name, std::function<void()> start,
+                        std::function<void()> finish, std::vector<TaskId> deps)
+{
+    const TaskId id = addTask(std::move(name), std::move(start), std::move(deps));
+    m_tasks[id].finish = std::move(finish);
+    m_tasks[id].is_comm = true;
+    return id;
+}
+
+bool
+TaskGraph::isReady (Task const& task) const
+{
+    return std::all_of(task.deps.begin(), task.deps.end(),
+        [this](TaskId d) { return m_tasks[d].state == State::Complete; });
+}
+
+void
+TaskGraph::execute ()
+{
+    ABLASTR_PROFILE("ablastr::utils::TaskGraph::execute");
+
+    std::size_t num_complete = 0;
+    std::deque<TaskId> in_flight;
+
+    while (num_complete < m_tasks.size())
+    {
+        // Post the messages of the communication tasks as early as possible
+        for (auto& task : m_tasks) {
+            if (task.is_comm && task.state == State::Waiting && isReady(task)) {
+                ABLASTR_PROFILE(task.name + "::start");
+                task.run();
+                task.state = State::Started;
+                in_flight.push_back(static_cast<TaskId>(&task - m_tasks.data()));
+            }
+        }
+
+        // Run the first compute task that is ready
+        auto next = std::find_if(m_tasks.begin(), m_tasks.end(), [this](Task const& task) {
+            return !task.is_comm && task.state == State::Waiting && isReady(task);
+        });
+        if (next != m_tasks.end()) {
+            ABLASTR_PROFILE(next->name);
+            next->run();
+            next->state = State::Complete;
+            ++num_complete;
+            continue;
+        }
+
+        // Nothing else can run: wait for the oldest messages
+        ABLASTR_ALWAYS_ASSERT_WITH_MESSAGE(!in_flight.empty(),
+            "TaskGraph: no task can run");
+        Task& task = m_tasks[in_flight.front()];
+        in_flight.pop_front();
+        {
+            ABLASTR_PROFILE(task.name + "::finish");
+            task.finish();
+        }
+        task.state = State::Complete;
+        ++num_complete;
+    }
+
+    m_tasks.clear();
+}
+
+}
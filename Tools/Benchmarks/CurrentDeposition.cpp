@@ -0,0 +1,204 @@
+/* Copyright 2025 The WarpX Community
+ *
+ * This file is part of WarpX.
+ *
+ * License: BSD-3-Clause-LBNL
+ */
+/* Micro-benchmark of the direct current deposition on a single CPU tile.
+ *
+ * Compares the reference kernel doDepositionShapeN against the
+ * cell-blocked kernel doDepositionShapeNCellBlocked for particles that
+ * are sorted by cell, as they are after WarpX sorts them for deposition.
+ *
+ * Runtime options (ParmParse prefix "benchmark"):
+ *   ncell   : number of cells per direction of the tile (default 32)
+ *   ppc     : number of particles per cell (default 64)
+ *   nrepeat : number of timed repetitions per kernel (default 5)
+ */
+#include "Particles/Deposition/CurrentDeposition.H"
+#include "Particles/Pusher/GetAndSetPosition.H"
+
+#include <AMReX.H>
+#include <AMReX_Box.H>
+#include <AMReX_FArrayBox.H>
+#include <AMReX_ParmParse.H>
+#include <AMReX_Print.H>
+#include <AMReX_Random.H>
+#include <AMReX_REAL.H>
+#include <AMReX_Utility.H>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+namespace
+{
+    struct BenchmarkParticles
+    {
+        std::vector<amrex::ParticleReal> x, y, z, theta;
+        std::vector<amrex::ParticleReal> w, ux, uy, uz;
+
+        [[nodiscard]] long size () const { return static_cast<long>(w.size()); }
+
+        [[nodiscard]] GetParticlePosition<PIdx> position () const
+        {
+            GetParticlePosition<PIdx> pos;
+#if defined(WARPX_DIM_3D)
+            pos.m_x = x.data();
+            pos.m_y = y.data();
+#elif defined(WARPX_DIM_XZ) || defined(WARPX_DIM_RZ)
+            pos.m_x = x.data();
+#endif
+            pos.m_z = z.data();
+#if defined(WARPX_DIM_RZ)
+            pos.m_theta = theta.data();
+#endif
+            return pos;
+        }
+    };
+
+    /** Generate ppc particles in each cell of [0, ncell)^dim, in cell order */
+    BenchmarkParticles
+    makeSortedParticles (int ncell, int ppc)
+    {
+        using namespace amrex::literals;
+
+        BenchmarkParticles p;
+        const amrex::Box cells(amrex::IntVect(0), amrex::IntVect(ncell-1));
+        const auto np = static_cast<std::size_t>(cells.numPts()) * ppc;
+        for (auto* v : {&p.x, &p.y, &p.z, &p.theta, &p.w, &p.ux, &p.uy, &p.uz}) {
+            v->reserve(np);
+        }
+
+        amrex::LoopOnCpu(cells, [&] (int i, int j, int k)
+        {
+            amrex::ignore_unused(i, j, k);
+            for (int ip = 0; ip < ppc; ++ip) {
+#if defined(WARPX_DIM_3D)
+                p.x.push_back(i + amrex::Random());
+                p.y.push_back(j + amrex::Random());
+                p.z.push_back(k + amrex::Random());
+#elif defined(WARPX_DIM_XZ) || defined(WARPX_DIM_RZ)
+                p.x.push_back(i + amrex::Random());
+                p.y.push_back(0._prt);
+                p.z.push_back(j + amrex::Random());
+#else
+                p.x.push_back(0._prt);
+                p.y.push_back(0._prt);
+                p.z.push_back(i + amrex::Random());
+#endif
+                p.theta.push_back(0._prt);
+                p.w.push_back(1._prt);
+                p.ux.push_back(amrex::RandomNormal(0., 1.e7));
+                p.uy.push_back(amrex::RandomNormal(0., 1.e7));
+                p.uz.push_back(amrex::RandomNormal(0., 1.e7));
+            }
+        });
+        return p;
+    }
+
+    amrex::Real maxRelativeDifference (const amrex::FArrayBox& ref, const amrex::FArrayBox& test)
+    {
+        const amrex::Real ref_max = ref.maxabs<amrex::RunOn::Host>(0);
+        amrex::FArrayBox diff(ref.box(), ref.nComp(), amrex::The_Cpu_Arena());
+        diff.copy<amrex::RunOn::Host>(ref);
+        diff.minus<amrex::RunOn::Host>(test);
+        const amrex::Real diff_max = diff.maxabs<amrex::RunOn::Host>(0);
+        return (ref_max > 0) ? diff_max/ref_max : diff_max;
+    }
+
+    template <int depos_order>
+    void runBenchmark (const BenchmarkParticles& p, int ncell, int nrepeat)
+    {
+        using namespace amrex::literals;
+
+        constexpr int ng = 4;
+        const amrex::Box tilebox = amrex::grow(
+            amrex::Box(amrex::IntVect(0), amrex::IntVect(ncell-1)), ng);
+
+#if defined(WARPX_DIM_3D)
+        const amrex::IntVect jx_type(0,1,1), jy_type(1,0,1), jz_type(1,1,0);
+#elif defined(WARPX_DIM_XZ) || defined(WARPX_DIM_RZ)
+        const amrex::IntVect jx_type(0,1), jy_type(1,1), jz_type(1,0);
+#else
+        const amrex::IntVect jx_type(1), jy_type(1), jz_type(0);
+#endif
+        std::vector<amrex::FArrayBox> j_ref, j_blk;
+        for (const auto& t : {jx_type, jy_type, jz_type}) {
+            j_ref.emplace_back(amrex::convert(tilebox, t), 1, amrex::The_Cpu_Arena());
+            j_blk.emplace_back(amrex::convert(tilebox, t), 1, amrex::The_Cpu_Arena());
+        }
+
+        // Unit cell size, with the tile lower corner at -ng
+        const amrex::XDim3 dinv{1._rt, 1._rt, 1._rt};
+        const amrex::XDim3 xyzmin{
+            AMREX_D_PICK(0._rt, -ng, -ng),
+            AMREX_D_PICK(0._rt, 0._rt, -ng),
+            AMREX_D_PICK(-ng, -ng, -ng)};
+        const amrex::Dim3 lo = amrex::lbound(tilebox);
+        const amrex::Real q = 1._rt;
+        const long np = p.size();
+        const auto pos = p.position();
+
+        auto time_kernel = [&] (std::vector<amrex::FArrayBox>& j, auto&& kernel)
+        {
+            amrex::Real best = std::numeric_limits<amrex::Real>::max();
+            for (int r = 0; r < nrepeat; ++r) {
+                for (auto& fab : j) { fab.setVal<amrex::RunOn::Host>(0._rt); }
+                const amrex::Real t0 = amrex::second();
+                kernel(j);
+                best = std::min(best, amrex::second() - t0);
+            }
+            return best;
+        };
+
+        const amrex::Real t_ref = time_kernel(j_ref, [&] (std::vector<amrex::FArrayBox>& j) {
+            doDepositionShapeN<depos_order>(
+                pos, p.w.data(), p.ux.data(), p.uy.data(), p.uz.data(), nullptr,
+                j[0], j[1], j[2], np, 0._rt, dinv, xyzmin, lo, q, 1);
+        });
+        const amrex::Real t_blk = time_kernel(j_blk, [&] (std::vector<amrex::FArrayBox>& j) {
+            doDepositionShapeNCellBlocked<depos_order>(
+                pos, p.w.data(), p.ux.data(), p.uy.data(), p.uz.data(), nullptr,
+                j[0], j[1], j[2], np, 0._rt, dinv, xyzmin, lo, q, 1);
+        });
+
+        amrex::Real max_diff = 0._rt;
+        for (int idir = 0; idir < 3; ++idir) {
+            max_diff = std::max(max_diff, maxRelativeDifference(j_ref[idir], j_blk[idir]));
+        }
+
+        amrex::Print() << "  order " << depos_order
+                       << ": reference " << 1.e9*t_ref/np << " ns/particle"
+                       << ", cell-blocked " << 1.e9*t_blk/np << " ns/particle"
+                       << ", speedup " << t_ref/t_blk
+                       << ", max relative difference " << max_diff << "\n";
+    }
+}
+
+int main (int argc, char* argv[])
+{
+    amrex::Initialize(argc, argv);
+    {
+        int ncell = 32;
+        int ppc = 64;
+        int nrepeat = 5;
+        const amrex::ParmParse pp("benchmark");
+        pp.query("ncell", ncell);
+        pp.query("ppc", ppc);
+        pp.query("nrepeat", nrepeat);
+
+        const auto particles = makeSortedParticles(ncell, ppc);
+
+        amrex::Print() << "Direct current deposition, " << AMREX_SPACEDIM << "D tile of "
+                       << ncell << " cells per direction, " << ppc << " particles per cell ("
+                       << particles.size() << " particles), best of " << nrepeat << " runs\n";
+
+        runBenchmark<1>(particles, ncell, nrepeat);
+        runBenchmark<2>(particles, ncell, nrepeat);
+        runBenchmark<3>(particles, ncell, nrepeat);
+        runBenchmark<4>(particles, ncell, nrepeat);
+    }
+    amrex::Finalize();
+}
@@ -0,0 +1,253 @@
+/* Copyright 2025 The WarpX Community
+ *
+ * This file is part of WarpX.
+ *
+ * License: BSD-3-Clause-LBNL
+ */
+/* Roofline-style micro-benchmark of the Yee FDTD field push on a single box.
+ *
+ * Compares the three separate sweeps of a step (B over dt/2, E over dt, B over
+ * dt/2, as done by EvolveB and EvolveE) against the cache-blocked single sweep
+ * of EvolveEBTemporalBlockingBox (algo.fdtd_temporal_blocking), for each block
+ * size. The memory bandwidth is measured with a STREAM-like triad on arrays of
+ * the same size as the fields, and each kernel is reported with its minimum
+ * memory traffic, arithmetic intensity and fraction of the bandwidth bound.
+ *
+ * Runtime options (ParmParse prefix "benchmark"):
+ *   ncell       : number of cells per direction transverse to z (default 32)
+ *   ncell_z     : number of cells along z, the last dimension (default 256)
+ *   block_sizes : block sizes of the blocked sweep (default 1 2 4 8 16)
+ *   nsteps      : number of steps per timed run (default 10)
+ *   nrepeat     : number of timed runs per kernel (default 5)
+ */
+#ifndef WARPX_DIM_RZ
+#   include "FieldSolver/FiniteDifferenceSolver/FiniteDifferenceAlgorithms/CartesianYeeAlgorithm.H"
+#   include "FieldSolver/FiniteDifferenceSolver/TemporalBlocking.H"
+#endif
+#include "Utils/WarpXConst.H"
+
+#include <AMReX.H>
+#include <AMReX_Box.H>
+#include <AMReX_FArrayBox.H>
+#include <AMReX_ParmParse.H>
+#include <AMReX_Print.H>
+#include <AMReX_Random.H>
+#include <AMReX_REAL.H>
+#include <AMReX_Utility.H>
+#include <AMReX_Vector.H>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#ifndef WARPX_DIM_RZ
+namespace
+{
+    /** Fields of a box, with one guard cell */
+    struct BoxFields
+    {
+        std::vector<amrex::FArrayBox> E, B, J;
+    };
+
+    BoxFields makeFields (const amrex::Box& cells)
+    {
+        using namespace amrex::literals;
+
+#if defined(WARPX_DIM_3D)
+        const amrex::IntVect ex_type(0,1,1), ey_type(1,0,1), ez_type(1,1,0);
+        const amrex::IntVect bx_type(1,0,0), by_type(0,1,0), bz_type(0,0,1);
+#elif defined(WARPX_DIM_XZ)
+        const amrex::IntVect ex_type(0,1), ey_type(1,1), ez_type(1,0);
+        const amrex::IntVect bx_type(1,0), by_type(0,0), bz_type(0,1);
+#else
+        const amrex::IntVect ex_type(1), ey_type(1), ez_type(0);
+        const amrex::IntVect bx_type(0), by_type(0), bz_type(1);
+#endif
+        BoxFields f;
+        const amrex::Box grown = amrex::grow(cells, 1);
+        for (const auto& t : {ex_type, ey_type, ez_type}) {
+            f.E.emplace_back(amrex::convert(grown, t), 1, amrex::The_Cpu_Arena());
+            f.J.emplace_back(amrex::convert(grown, t), 1, amrex::The_Cpu_Arena());
+        }
+        for (const auto& t : {bx_type, by_type, bz_type}) {
+            f.B.emplace_back(amrex::convert(grown, t), 1, amrex::The_Cpu_Arena());
+        }
+        for (auto* v : {&f.E, &f.B, &f.J}) {
+            for (auto& fab : *v) {
+                amrex::Array4<amrex::Real> const a = fab.array();
+                amrex::LoopOnCpu(fab.box(), [&] (int i, int j, int k) {
+                    a(i,j,k) = amrex::RandomNormal(0., 1.);
+                });
+            }
+        }
+        for (auto& fab : f.E) { fab.mult<amrex::RunOn::Host>(PhysConst::c); }
+        for (auto& fab : f.J) { fab.mult<amrex::RunOn::Host>(1.e-3_rt); }
+        return f;
+    }
+
+    amrex::Real maxRelativeDifference (const amrex::FArrayBox& ref, const amrex::FArrayBox& test)
+    {
+        const amrex::Real ref_max = ref.maxabs<amrex::RunOn::Host>(0);
+        amrex::FArrayBox diff(ref.box(), ref.nComp(), amrex::The_Cpu_Arena());
+        diff.copy<amrex::RunOn::Host>(ref);
+        diff.minus<amrex::RunOn::Host>(test);
+        const amrex::Real diff_max = diff.maxabs<amrex::RunOn::Host>(0);
+        return (ref_max > 0) ? diff_max/ref_max : diff_max;
+    }
+
+    /** Best time of a STREAM-like triad a = b + s*c over n elements, and its bandwidth */
+    amrex::Real triadBandwidth (long n, int nrepeat)
+    {
+        using namespace amrex::literals;
+
+        std::vector<amrex::Real> a(n, 0._rt), b(n, 1._rt), c(n, 2._rt);
+        amrex::Real* AMREX_RESTRICT pa = a.data();
+        const amrex::Real* AMREX_RESTRICT pb = b.data();
+        const amrex::Real* AMREX_RESTRICT pc = c.data();
+        const amrex::Real s = 3._rt;
+        amrex::Real best = std::numeric_limits<amrex::Real>::max();
+        for (int r = 0; r < nrepeat; ++r) {
+            const amrex::Real t0 = amrex::second();
+            for (long i = 0; i < n; ++i) { pa[i] = pb[i] + s*pc[i]; }
+            best = std::min(best, amrex::second() - t0);
+        }
+        // Two arrays read and one written (ignoring the write-allocate traffic)
+        return 3._rt * sizeof(amrex::Real) * n / best;
+    }
+}
+#endif
+
+int main (int argc, char* argv[])
+{
+    amrex::Initialize(argc, argv);
+    {
+#ifdef WARPX_DIM_RZ
+        amrex::Print() << "The Cartesian FDTD benchmark is not available in RZ geometry\n";
+#else
+        using namespace amrex::literals;
+
+        int ncell = 32;
+        int ncell_z = 256;
+        amrex::Vector<int> block_sizes = {1, 2, 4, 8, 16};
+        int nsteps = 10;
+        int nrepeat = 5;
+        const amrex::ParmParse pp("benchmark");
+        pp.query("ncell", ncell);
+        pp.query("ncell_z", ncell_z);
+        pp.queryarr("block_sizes", block_sizes);
+        pp.query("nsteps", nsteps);
+        pp.query("nrepeat", nrepeat);
+
+        constexpr int zdir = AMREX_SPACEDIM - 1;
+        amrex::IntVect hi(ncell - 1);
+        hi[zdir] = ncell_z - 1;
+        const amrex::Box cells(amrex::IntVect(0), hi);
+        const auto ncells = static_cast<amrex::Real>(cells.numPts());
+
+        // Unit cell size, at the Courant limit
+        std::array<amrex::Real, 3> cell_size = {1._rt, 1._rt, 1._rt};
+        amrex::Vector<amrex::Real> coefs_x, coefs_y, coefs_z;
+        CartesianYeeAlgorithm::InitializeStencilCoefficients(cell_size, coefs_x, coefs_y, coefs_z);
+        const CartesianStencilCoefs stencil{
+            coefs_x.data(), static_cast<int>(coefs_x.size()),
+            coefs_y.data(), static_cast<int>(coefs_y.size()),
+            coefs_z.data(), static_cast<int>(coefs_z.size())};
+        const amrex::Real dt = 0.99_rt * CartesianYeeAlgorithm::ComputeMaxDt(cell_size.data());
+
+        const BoxFields initial = makeFields(cells);
+
+        // The valid cells are updated, the guard cells are left unchanged
+        std::array<amrex::Box, 3> tb_E, tb_B;
+        for (int idir = 0; idir < 3; ++idir) {
+            tb_E[idir] = amrex::convert(cells, initial.E[idir].box().ixType());
+            tb_B[idir] = amrex::convert(cells, initial.B[idir].box().ixType());
+        }
+
+        auto time_kernel = [&] (BoxFields& f, auto&& step)
+        {
+            amrex::Real best = std::numeric_limits<amrex::Real>::max();
+            for (int r = 0; r < nrepeat; ++r) {
+                for (int idir = 0; idir < 3; ++idir) {
+                    f.E[idir].copy<amrex::RunOn::Host>(initial.E[idir]);
+                    f.B[idir].copy<amrex::RunOn::Host>(initial.B[idir]);
+                }
+                const amrex::Real t0 = amrex::second();
+                for (int n = 0; n < nsteps; ++n) { step(f); }
+                best = std::min(best, amrex::second() - t0);
+            }
+            return best / nsteps;
+        };
+
+        const auto arrays = [] (BoxFields& f) {
+            return std::array<amrex::Array4<amrex::Real>, 9>{
+                f.E[0].array(), f.E[1].array(), f.E[2].array(),
+                f.B[0].array(), f.B[1].array(), f.B[2].array(),
+                f.J[0].array(), f.J[1].array(), f.J[2].array()};
+        };
+
+        // Minimum memory traffic per cell and step (in number of reals): each sweep
+        // reads the fields it uses once and writes the updated ones once
+        constexpr amrex::Real words_separate = 9 + 12 + 9; // B: E, B -> B; E: E, B, J -> E
+        constexpr amrex::Real words_blocked = 9 + 6;       // E, B, J -> E, B
+        // Floating-point operations per cell and step of the Yee push
+        constexpr amrex::Real flops = 3*8 + 3*10 + 3*8;
+
+        const amrex::Real bandwidth = triadBandwidth(3*initial.E[0].box().numPts(), nrepeat);
+
+        amrex::Print() << "Yee FDTD step, " << AMREX_SPACEDIM << "D box of " << cells.size()
+                       << " cells, best of " << nrepeat << " runs of " << nsteps << " steps\n"
+                       << "  triad bandwidth " << 1.e-9*bandwidth << " GB/s\n";
+
+        auto report = [&] (const char* name, amrex::Real t, amrex::Real words)
+        {
+            const amrex::Real bytes = words * sizeof(amrex::Real) * ncells;
+            const amrex::Real t_bound = bytes / bandwidth;
+            amrex::Print() << "  " << name
+                           << ": " << 1.e9*t/ncells << " ns/cell"
+                           << ", " << 1.e-9*flops*ncells/t << " GFlop/s"
+                           << ", intensity " << flops/(words*sizeof(amrex::Real)) << " Flop/B"
+                           << ", " << 1.e-9*bytes/t << " GB/s"
+                           << " (" << 100.*t_bound/t << "% of the bandwidth bound)";
+        };
+
+        BoxFields f_ref = makeFields(cells);
+        for (int idir = 0; idir < 3; ++idir) { f_ref.J[idir].copy<amrex::RunOn::Host>(initial.J[idir]); }
+        const amrex::Real t_ref = time_kernel(f_ref, [&] (BoxFields& f) {
+            auto const a = arrays(f);
+            EvolveBBox<CartesianYeeAlgorithm>(a[3], a[4], a[5], a[0], a[1], a[2],
+                tb_B[0], tb_B[1], tb_B[2], stencil, 0.5_rt*dt);
+            EvolveEBox<CartesianYeeAlgorithm>(a[0], a[1], a[2], a[3], a[4], a[5], a[6], a[7], a[8],
+                tb_E[0], tb_E[1], tb_E[2], stencil, dt);
+            EvolveBBox<CartesianYeeAlgorithm>(a[3], a[4], a[5], a[0], a[1], a[2],
+                tb_B[0], tb_B[1], tb_B[2], stencil, 0.5_rt*dt);
+        });
+        report("separate sweeps", t_ref, words_separate);
+        amrex::Print() << "\n";
+
+        for (const int block_size : block_sizes) {
+            BoxFields f_blk = makeFields(cells);
+            for (int idir = 0; idir < 3; ++idir) { f_blk.J[idir].copy<amrex::RunOn::Host>(initial.J[idir]); }
+            const amrex::Real t_blk = time_kernel(f_blk, [&] (BoxFields& f) {
+                auto const a = arrays(f);
+                EvolveEBTemporalBlockingBox<CartesianYeeAlgorithm>(
+                    a[0], a[1], a[2], a[3], a[4], a[5], a[6], a[7], a[8],
+                    tb_B, tb_E, tb_B, stencil, dt, block_size);
+            });
+
+            amrex::Real max_diff = 0._rt;
+            for (int idir = 0; idir < 3; ++idir) {
+                max_diff = std::max(max_diff, maxRelativeDifference(f_ref.E[idir], f_blk.E[idir]));
+                max_diff = std::max(max_diff, maxRelativeDifference(f_ref.B[idir], f_blk.B[idir]));
+            }
+
+            amrex::Print() << "  block size " << block_size << " -";
+            report("blocked sweep", t_blk, words_blocked);
+            amrex::Print() << ", speedup " << t_ref/t_blk
+                           << ", max relative difference " << max_diff << "\n";
+        }
+#endif
+    }
+    amrex::Finalize();
+}
@@ -0,0 +1,179 @@
+/* Copyright 2025 The WarpX Community
+ *
+ * This file is part of WarpX.
+ *
+ * License: BSD-3-Clause-LBNL
+ */
+/* Micro-benchmark of the particle momentum and position push.
+ *
+ * Compares, for a plain Boris electron species, the generic push used by
+ * PushPX (doParticleMomentumPush, which selects the pusher, the radiation
+ * reaction and the ionization level of every particle at runtime) against
+ * the compile-time specialized Boris push selected by selectPushKernel.
+ * The fields are stored per particle so that the timing excludes the gather.
+ *
+ * Runtime options (ParmParse prefix "benchmark"):
+ *   np      : number of particles (default 4194304)
+ *   nrepeat : number of timed repetitions per kernel (default 5)
+ */
+#ifdef WARPX_QED
+#   include "Particles/ElementaryProcess/QEDInternals/QedChiFunctions.H"
+#endif
+#include "Particles/Pusher/PushSelector.H"
+#include "Particles/Pusher/UpdateMomentumBoris.H"
+#include "Particles/Pusher/UpdatePosition.H"
+#include "Utils/WarpXAlgorithmSelection.H"
+#include "Utils/WarpXConst.H"
+
+#include <AMReX.H>
+#include <AMReX_GpuLaunch.H>
+#include <AMReX_ParmParse.H>
+#include <AMReX_Print.H>
+#include <AMReX_Random.H>
+#include <AMReX_REAL.H>
+#include <AMReX_Utility.H>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+namespace
+{
+    struct BenchmarkParticles
+    {
+        std::vector<amrex::ParticleReal> x, y, z, ux, uy, uz;
+        std::vector<amrex::ParticleReal> Ex, Ey, Ez, Bx, By, Bz;
+    };
+
+    BenchmarkParticles makeParticles (long np)
+    {
+        BenchmarkParticles p;
+        for (auto* v : {&p.x, &p.y, &p.z, &p.ux, &p.uy, &p.uz,
+                        &p.Ex, &p.Ey, &p.Ez, &p.Bx, &p.By, &p.Bz}) {
+            v->resize(np);
+        }
+        for (long i = 0; i < np; ++i) {
+            p.x[i] = amrex::Random();
+            p.y[i] = amrex::Random();
+            p.z[i] = amrex::Random();
+            p.ux[i] = amrex::RandomNormal(0., 1.e7);
+            p.uy[i] = amrex::RandomNormal(0., 1.e7);
+            p.uz[i] = amrex::RandomNormal(0., 1.e7);
+            p.Ex[i] = amrex::RandomNormal(0., 1.e9);
+            p.Ey[i] = amrex::RandomNormal(0., 1.e9);
+            p.Ez[i] = amrex::RandomNormal(0., 1.e9);
+            p.Bx[i] = amrex::RandomNormal(0., 1.);
+            p.By[i] = amrex::RandomNormal(0., 1.);
+            p.Bz[i] = amrex::RandomNormal(0., 1.);
+        }
+        return p;
+    }
+
+    /** Push all particles with the kernel selected by push_runtime_flag */
+    void push (BenchmarkParticles& p, int push_runtime_flag, amrex::Real dt)
+    {
+        const long np = static_cast<long>(p.x.size());
+        amrex::ParticleReal* AMREX_RESTRICT x = p.x.data();
+        amrex::ParticleReal* AMREX_RESTRICT y = p.y.data();
+        amrex::ParticleReal* AMREX_RESTRICT z = p.z.data();
+        amrex::ParticleReal* AMREX_RESTRICT ux = p.ux.data();
+        amrex::ParticleReal* AMREX_RESTRICT uy = p.uy.data();
+        amrex::ParticleReal* AMREX_RESTRICT uz = p.uz.data();
+        const amrex::ParticleReal* AMREX_RESTRICT Ex = p.Ex.data();
+        const amrex::ParticleReal* AMREX_RESTRICT Ey = p.Ey.data();
+        const amrex::ParticleReal* AMREX_RESTRICT Ez = p.Ez.data();
+        const amrex::ParticleReal* AMREX_RESTRICT Bx = p.Bx.data();
+        const amrex::ParticleReal* AMREX_RESTRICT By = p.By.data();
+        const amrex::ParticleReal* AMREX_RESTRICT Bz = p.Bz.data();
+
+        // Same arguments as PushPX for an electron species without ionization
+        const int* ion_lev = nullptr;
+        const amrex::ParticleReal q = -PhysConst::q_e;
+        const amrex::ParticleReal m = PhysConst::m_e;
+        const auto pusher_algo = ParticlePusherAlgo::Boris;
+        const int do_crr = 0;
+#ifdef WARPX_QED
+        const amrex::Real t_chi_max = 0.0;
+#endif
+
+        amrex::ParallelFor(
+            amrex::TypeList<amrex::CompileTimeOptions<generic_push,boris_push>>{},
+            {push_runtime_flag},
+            np,
+            [=] AMREX_GPU_DEVICE (long ip, auto push_control)
+        {
+            if constexpr (push_control == boris_push) {
+                UpdateMomentumBoris(ux[ip], uy[ip], uz[ip],
+                                    Ex[ip], Ey[ip], Ez[ip], Bx[ip], By[ip], Bz[ip],
+                                    q, m, dt);
+            } else {
+                doParticleMomentumPush<0>(ux[ip], uy[ip], uz[ip],
+                                          Ex[ip], Ey[ip], Ez[ip], Bx[ip], By[ip], Bz[ip],
+                                          ion_lev ? ion_lev[ip] : 1,
+                                          m, q, pusher_algo, do_crr,
+#ifdef WARPX_QED
+                                          t_chi_max,
+#endif
+                                          dt);
+            }
+            UpdatePosition(x[ip], y[ip], z[ip], ux[ip], uy[ip], uz[ip], dt);
+        });
+    }
+
+    amrex::Real maxRelativeDifference (const std::vector<amrex::ParticleReal>& ref,
+                                       const std::vector<amrex::ParticleReal>& test)
+    {
+        amrex::Real ref_max = 0, diff_max = 0;
+        for (std::size_t i = 0; i < ref.size(); ++i) {
+            ref_max = std::max(ref_max, amrex::Real(std::abs(ref[i])));
+            diff_max = std::max(diff_max, amrex::Real(std::abs(ref[i] - test[i])));
+        }
+        return (ref_max > 0) ? diff_max/ref_max : diff_max;
+    }
+}
+
+int main (int argc, char* argv[])
+{
+    amrex::Initialize(argc, argv);
+    {
+        long np = 4194304;
+        int nrepeat = 5;
+        const amrex::ParmParse pp("benchmark");
+        pp.query("np", np);
+        pp.query("nrepeat", nrepeat);
+
+        const auto initial = makeParticles(np);
+        const amrex::Real dt = 1.e-15;
+
+        auto time_kernel = [&] (BenchmarkParticles& p, int push_runtime_flag)
+        {
+            amrex::Real best = std::numeric_limits<amrex::Real>::max();
+            for (int r = 0; r < nrepeat; ++r) {
+                p = initial;
+                const amrex::Real t0 = amrex::second();
+                push(p, push_runtime_flag, dt);
+                best = std::min(best, amrex::second() - t0);
+            }
+            return best;
+        };
+
+        BenchmarkParticles p_generic, p_boris;
+        const amrex::Real t_generic = time_kernel(p_generic, generic_push);
+        const amrex::Real t_boris = time_kernel(p_boris, selectPushKernel(ParticlePusherAlgo::Boris, false, false));
+
+        amrex::Real max_diff = 0;
+        for (auto mem : {&BenchmarkParticles::x, &BenchmarkParticles::y, &BenchmarkParticles::z,
+                         &BenchmarkParticles::ux, &BenchmarkParticles::uy, &BenchmarkParticles::uz}) {
+            max_diff = std::max(max_diff, maxRelativeDifference(p_generic.*mem, p_boris.*mem));
+        }
+
+        amrex::Print() << "Boris push of an electron species, " << np
+                       << " particles, best of " << nrepeat << " runs\n"
+                       << "  generic " << 1.e9*t_generic/np << " ns/particle"
+                       << ", specialized " << 1.e9*t_boris/np << " ns/particle"
+                       << ", speedup " << t_generic/t_boris
+                       << ", max relative difference " << max_diff << "\n";
+    }
+    amrex::Finalize();
+}
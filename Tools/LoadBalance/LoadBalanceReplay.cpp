@@ -0,0 +1,403 @@
+/* Copyright 2025 The WarpX Community
+ *
+ * This file is part of WarpX.
+ *
+ * License: BSD-3-Clause-LBNL
+ */
+/* Offline replay of the load balancing strategies on the costs recorded by the
+ * `LoadBalanceCosts` reduced diagnostic.
+ *
+ * Each row of the file is treated as a load balancing step. For each strategy
+ * (knapsack with each knapsack factor, SFC, incremental diffusion), the
+ * distribution mapping is replayed from the recorded mapping of the first row:
+ * at each row, the strategy proposes a new mapping from the recorded costs of
+ * the boxes, which is adopted with the same criterion as in WarpX::LoadBalance,
+ * and the predicted efficiency and data movement are reported.
+ *
+ * The recorded file does not contain the extent of the boxes, which is
+ * reconstructed from the lower corners of all boxes of a level (the box
+ * extends up to the next lower corner in each direction).
+ *
+ * Runtime options (ParmParse prefix "replay"):
+ *   file                           : LoadBalanceCosts file (default diags/reducedfiles/LBC.txt)
+ *   nprocs                         : number of MPI processes (default: from the recorded mapping)
+ *   strategies                     : any of knapsack sfc diffusion (default: all)
+ *   knapsack_factors               : values of algo.load_balance_knapsack_factor (default 1.24)
+ *   efficiency_ratio_threshold     : algo.load_balance_efficiency_ratio_threshold (default 1.1)
+ *   max_bytes_moved                : algo.load_balance_max_bytes_moved (default 0)
+ *   bytes_per_cell                 : bytes of field data per cell (default 192)
+ *   bytes_per_particle             : bytes of data per macroparticle (default 64)
+ *   verbose                        : print each row, not only the summary (default 1)
+ */
+#include "Parallelization/DiffusionLoadBalance.H"
+
+#include <AMReX.H>
+#include <AMReX_Box.H>
+#include <AMReX_BoxArray.H>
+#include <AMReX_BoxList.H>
+#include <AMReX_DistributionMapping.H>
+#include <AMReX_INT.H>
+#include <AMReX_IntVect.H>
+#include <AMReX_ParmParse.H>
+#include <AMReX_Print.H>
+#include <AMReX_REAL.H>
+#include <AMReX_Vector.H>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+    //! Data of a box in a row of the LoadBalanceCosts file
+    struct BoxRecord
+    {
+        int lev = 0;
+        int proc = 0;
+        std::array<int,3> lo{0, 0, 0};
+        double cost = 0.;
+        double cells = 0.;
+        double particles = 0.;
+    };
+
+    //! A row of the LoadBalanceCosts file
+    struct Row
+    {
+        long step = 0;
+        std::map<int, std::vector<BoxRecord>> levels;
+    };
+
+    //! Position of the fields of a box in a row, from the header of the file
+    struct Layout
+    {
+        int nfields = 0;
+        int cost = -1, proc = -1, lev = -1, i_low = -1, j_low = -1, k_low = -1;
+        int cells = -1, particles = -1;
+    };
+
+    Layout readHeader (std::string const& header)
+    {
+        // Tokens look like "[2]cost_box_0()"
+        Layout layout;
+        std::istringstream iss(header.substr(1));
+        std::string token;
+        int itoken = 0;
+        while (iss >> token) {
+            const auto name = token.substr(token.find(']') + 1);
+            if (itoken++ < 2) { continue; } // step, time
+            if (name.size() < 4 || name.compare(name.size() - 4, 4, "_0()") != 0) { break; }
+            const auto field = name.substr(0, name.size() - 4);
+            const int i = layout.nfields++;
+            if (field == "cost_box") { layout.cost = i; }
+            else if (field == "proc_box") { layout.proc = i; }
+            else if (field == "lev_box") { layout.lev = i; }
+            else if (field == "i_low_box") { layout.i_low = i; }
+            else if (field == "j_low_box") { layout.j_low = i; }
+            else if (field == "k_low_box") { layout.k_low = i; }
+            else if (field == "num_cells") { layout.cells = i; }
+            else if (field == "num_macro_particles") { layout.particles = i; }
+        }
+        if (layout.cost < 0 || layout.proc < 0 || layout.lev < 0 || layout.i_low < 0) {
+            amrex::Abort("LoadBalanceReplay: unexpected header in the LoadBalanceCosts file");
+        }
+        return layout;
+    }
+
+    std::vector<Row> readCosts (std::string const& filename)
+    {
+        std::ifstream ifs(filename);
+        if (!ifs) { amrex::Abort("LoadBalanceReplay: cannot open " + filename); }
+
+        std::string line;
+        std::getline(ifs, line);
+        if (line.empty() || line[0] != '#') {
+            amrex::Abort("LoadBalanceReplay: " + filename + " has no header; "
+                         "it is written at the last step of the simulation");
+        }
+        std::replace(line.begin(), line.end(), ',', ' ');
+        const Layout layout = readHeader(line);
+
+        std::vector<Row> rows;
+        while (std::getline(ifs, line))
+        {
+            std::replace(line.begin(), line.end(), ',', ' ');
+            std::istringstream iss(line);
+            std::vector<std::string> tokens;
+            for (std::string t; iss >> t;) { tokens.push_back(t); }
+            if (tokens.size() < 2) { continue; }
+
+            Row row;
+            row.step = std::stol(tokens[0]);
+            const int nboxes = static_cast<int>(tokens.size() - 2)/layout.nfields;
+            for (int b = 0; b < nboxes; ++b)
+            {
+                auto const value = [&] (int field) {
+                    return (field < 0) ? 0. : std::strtod(tokens[2 + b*layout.nfields + field].c_str(), nullptr);
+                };
+                // the rows are padded with NaN up to the maximum number of boxes
+                if (std::isnan(value(layout.cost))) { continue; }
+                BoxRecord box;
+                box.cost = value(layout.cost);
+                box.proc = static_cast<int>(value(layout.proc));
+                box.lev = static_cast<int>(value(layout.lev));
+                box.lo = {static_cast<int>(value(layout.i_low)),
+                          static_cast<int>(value(layout.j_low)),
+                          static_cast<int>(value(layout.k_low))};
+                box.cells = value(layout.cells);
+                box.particles = value(layout.particles);
+                row.levels[box.lev].push_back(box);
+            }
+            rows.push_back(row);
+        }
+        return rows;
+    }
+
+    /** Reconstruct the boxes of a level from their lower corners: in each direction,
+     * a box extends up to the next lower corner of the level, and the last boxes have
+     * the same extent as the previous ones (or as given by their number of cells) */
+    amrex::BoxArray makeBoxArray (std::vector<BoxRecord> const& boxes)
+    {
+        std::array<std::vector<int>, AMREX_SPACEDIM> lines;
+        for (int d = 0; d < AMREX_SPACEDIM; ++d) {
+            for (auto const& box : boxes) { lines[d].push_back(box.lo[d]); }
+            std::sort(lines[d].begin(), lines[d].end());
+            lines[d].erase(std::unique(lines[d].begin(), lines[d].end()), lines[d].end());
+        }
+
+        amrex::BoxList bl;
+        for (auto const& box : boxes)
+        {
+            amrex::IntVect lo, hi;
+            std::vector<int> unknown;
+            double known_cells = 1.;
+            for (int d = 0; d < AMREX_SPACEDIM; ++d) {
+                auto const& l = lines[d];
+                const auto k = static_cast<int>(
+                    std::distance(l.begin(), std::lower_bound(l.begin(), l.end(), box.lo[d])));
+                const int size = static_cast<int>(l.size());
+                int extent = 0;
+                if (k+1 < size) { extent = l[k+1] - l[k]; }
+                else if (size > 1) { extent = l[k] - l[k-1]; }
+                else { unknown.push_back(d); }
+                lo[d] = box.lo[d];
+                hi[d] = box.lo[d] + extent - 1;
+                if (extent > 0) { known_cells *= extent; }
+            }
+            if (!unknown.empty()) {
+                const double remaining = std::max(1., box.cells/known_cells);
+                const int extent = std::max(1, static_cast<int>(std::lround(
+                    std::pow(remaining, 1./static_cast<double>(unknown.size())))));
+                for (const int d : unknown) { hi[d] = lo[d] + extent - 1; }
+            }
+            bl.push_back(amrex::Box(lo, hi));
+        }
+        return amrex::BoxArray(bl);
+    }
+
+    //! Average cost per process divided by the maximum, as in WarpX::LoadBalance
+    amrex::Real efficiency (amrex::Vector<amrex::Real> const& costs,
+                            amrex::Vector<int> const& pmap, int nprocs)
+    {
+        std::vector<double> load(nprocs, 0.);
+        for (int b = 0; b < static_cast<int>(costs.size()); ++b) { load[pmap[b]] += costs[b]; }
+        double total = 0.;
+        for (const auto l : load) { total += l; }
+        const double max_load = *std::max_element(load.begin(), load.end());
+        return (max_load > 0.) ? static_cast<amrex::Real>(total/nprocs/max_load) : amrex::Real(1);
+    }
+
+    //! Integer weights, scaled as in amrex::DistributionMapping::makeKnapSack and makeSFC
+    std::vector<amrex::Long> integerWeights (amrex::Vector<amrex::Real> const& costs)
+    {
+        const amrex::Real wmax = *std::max_element(costs.begin(), costs.end());
+        const amrex::Real scale = (wmax == 0) ? amrex::Real(1.e9) : amrex::Real(1.e9)/wmax;
+        std::vector<amrex::Long> wgts(costs.size());
+        for (std::size_t i = 0; i < costs.size(); ++i) {
+            wgts[i] = static_cast<amrex::Long>(costs[i]*scale) + 1L;
+        }
+        return wgts;
+    }
+
+    //! A strategy and its parameters, with the replayed distribution mapping of each level
+    struct Strategy
+    {
+        std::string name;
+        amrex::Real knapsack_factor = 0;
+        std::map<int, amrex::Vector<int>> pmap;
+        std::map<int, amrex::BoxArray> ba;
+        // statistics over the rows
+        int nrows = 0;
+        int nadopted = 0;
+        double sum_efficiency = 0.;
+        double sum_proposed = 0.;
+        amrex::Long bytes_moved = 0;
+        amrex::Long boxes_moved = 0;
+    };
+}
+
+int main (int argc, char* argv[])
+{
+    amrex::Initialize(argc, argv);
+    {
+        std::string filename = "diags/reducedfiles/LBC.txt";
+        int nprocs = 0;
+        std::vector<std::string> strategy_names = {"knapsack", "sfc", "diffusion"};
+        std::vector<amrex::Real> knapsack_factors = {amrex::Real(1.24)};
+        amrex::Real threshold = amrex::Real(1.1);
+        amrex::Real max_bytes_moved = 0;
+        amrex::Real bytes_per_cell = 192;
+        amrex::Real bytes_per_particle = 64;
+        int verbose = 1;
+
+        const amrex::ParmParse pp("replay");
+        pp.query("file", filename);
+        pp.query("nprocs", nprocs);
+        pp.queryarr("strategies", strategy_names);
+        pp.queryarr("knapsack_factors", knapsack_factors);
+        pp.query("efficiency_ratio_threshold", threshold);
+        pp.query("max_bytes_moved", max_bytes_moved);
+        pp.query("bytes_per_cell", bytes_per_cell);
+        pp.query("bytes_per_particle", bytes_per_particle);
+        pp.query("verbose", verbose);
+
+        const std::vector<Row> rows = readCosts(filename);
+        if (rows.empty()) { amrex::Abort("LoadBalanceReplay: no data in " + filename); }
+        if (nprocs <= 0) {
+            for (auto const& row : rows) {
+                for (auto const& [lev, boxes] : row.levels) {
+                    for (auto const& box : boxes) { nprocs = std::max(nprocs, box.proc + 1); }
+                }
+            }
+        }
+
+        std::vector<Strategy> strategies;
+        for (auto const& name : strategy_names) {
+            if (name == "knapsack") {
+                for (const auto f : knapsack_factors) { strategies.push_back({name, f}); }
+            } else if (name == "sfc" || name == "diffusion") {
+                strategies.push_back({name});
+            } else {
+                amrex::Abort("LoadBalanceReplay: unknown strategy " + name);
+            }
+        }
+
+        amrex::Print() << "Replaying " << rows.size() << " load balancing steps of " << filename
+                       << " on " << nprocs << " MPI processes\n";
+        if (verbose) {
+            amrex::Print() << "# strategy step level efficiency proposed_efficiency adopted boxes_moved MiB_moved\n";
+        }
+
+        for (auto const& row : rows)
+        {
+            for (auto const& [lev, boxes] : row.levels)
+            {
+                const int nboxes = static_cast<int>(boxes.size());
+                amrex::Vector<amrex::Real> costs(nboxes);
+                amrex::Vector<amrex::Long> bytes(nboxes);
+                amrex::Vector<int> recorded_pmap(nboxes);
+                for (int b = 0; b < nboxes; ++b) {
+                    costs[b] = static_cast<amrex::Real>(boxes[b].cost);
+                    bytes[b] = static_cast<amrex::Long>(bytes_per_cell*boxes[b].cells
+                                                        + bytes_per_particle*boxes[b].particles);
+                    recorded_pmap[b] = boxes[b].proc;
+                }
+                const amrex::BoxArray ba = makeBoxArray(boxes);
+
+                for (auto& s : strategies)
+                {
+                    // Start from (or, after a regrid, restart from) the recorded mapping
+                    if (s.ba.count(lev) == 0 || s.ba[lev] != ba) {
+                        s.ba[lev] = ba;
+                        s.pmap[lev] = recorded_pmap;
+                    }
+                    auto& pmap = s.pmap[lev];
+
+                    const amrex::Real current = efficiency(costs, pmap, nprocs);
+                    amrex::Vector<int> new_pmap;
+                    amrex::Real eff = 0;
+                    bool adopted = false;
+                    if (s.name == "diffusion")
+                    {
+                        amrex::Real proposed_eff = 0;
+                        new_pmap = warpx::load_balance::makeDiffusion(
+                            ba, pmap, costs, bytes, nprocs, threshold,
+                            static_cast<amrex::Long>(max_bytes_moved), eff, proposed_eff);
+                        eff = efficiency(costs, new_pmap, nprocs);
+                        // the diffusion strategy already stops at the threshold
+                        adopted = (eff > current);
+                    }
+                    else
+                    {
+                        amrex::DistributionMapping dm;
+                        const auto wgts = integerWeights(costs);
+                        if (s.name == "sfc") {
+                            dm.SFCProcessorMap(ba, wgts, nprocs, eff);
+                        } else {
+                            const int nmax = static_cast<int>(std::ceil(
+                                amrex::Real(nboxes)/amrex::Real(nprocs)*s.knapsack_factor));
+                            dm.KnapSackProcessorMap(wgts, nprocs, &eff, true, nmax);
+                        }
+                        new_pmap = dm.ProcessorMap();
+                        eff = efficiency(costs, new_pmap, nprocs);
+                        adopted = (threshold > 0) && (eff > threshold*current);
+                    }
+
+                    int moved = 0;
+                    amrex::Long moved_bytes = 0;
+                    if (adopted) {
+                        for (int b = 0; b < nboxes; ++b) {
+                            if (new_pmap[b] != pmap[b]) { ++moved; moved_bytes += bytes[b]; }
+                        }
+                        pmap = new_pmap;
+                    }
+
+                    ++s.nrows;
+                    s.nadopted += adopted ? 1 : 0;
+                    s.sum_efficiency += current;
+                    s.sum_proposed += adopted ? eff : current;
+                    s.boxes_moved += moved;
+                    s.bytes_moved += moved_bytes;
+
+                    if (verbose) {
+                        std::ostringstream label;
+                        label << s.name;
+                        if (s.name == "knapsack") { label << "(" << s.knapsack_factor << ")"; }
+                        amrex::Print() << std::setw(16) << std::left << label.str() << std::right
+                                       << " " << row.step << " " << lev
+                                       << std::fixed << std::setprecision(4)
+                                       << " " << current << " " << eff << " " << adopted
+                                       << " " << moved
+                                       << std::setprecision(2)
+                                       << " " << static_cast<double>(moved_bytes)/(1024.*1024.) << "\n";
+                    }
+                }
+            }
+        }
+
+        amrex::Print() << "\nSummary (efficiency: before balancing, averaged over the steps and levels;"
+                       << " balanced: after the adopted balancing)\n"
+                       << "# strategy efficiency balanced adopted boxes_moved MiB_moved\n";
+        for (auto const& s : strategies)
+        {
+            std::ostringstream label;
+            label << s.name;
+            if (s.name == "knapsack") { label << "(" << s.knapsack_factor << ")"; }
+            amrex::Print() << std::setw(16) << std::left << label.str() << std::right
+                           << std::fixed << std::setprecision(4)
+                           << " " << s.sum_efficiency/s.nrows
+                           << " " << s.sum_proposed/s.nrows
+                           << " " << s.nadopted << "/" << s.nrows
+                           << " " << s.boxes_moved
+                           << std::setprecision(2)
+                           << " " << static_cast<double>(s.bytes_moved)/(1024.*1024.) << "\n";
+        }
+    }
+    amrex::Finalize();
+}
@@ -71,22 +71,31 @@ class SimData:
                 "".join([ln for ln in w if not ln.isdigit()]) for w in h.split()
             ][2::]
 
-        # Either 9 or 10 depending if GPU
-        n_data_fields = 9 if len(set(unique_headers)) % 9 == 0 else 10
+        # Either 14 or 15 depending if GPU
+        n_data_fields = 14 if len(set(unique_headers)) % 14 == 0 else 15
         f.close()
 
         # From data header, data layout is:
         #     [step, time,
         #      cost_box_0, proc_box_0, lev_box_0, i_low_box_0, j_low_box_0,
         #           k_low_box_0, num_cells_0, num_macro_particles_0,
-        #           (, gpu_ID_box_0 if GPU run), hostname_box_0,
+        #           (, gpu_ID_box_0 if GPU run), cost_gather_push_box_0,
+        #           cost_deposition_box_0, cost_field_solve_box_0,
+        #           cost_collisions_box_0,
+        #           cost_particle_creation_box_0, hostname_box_0,
         #      cost_box_1, proc_box_1, lev_box_1, i_low_box_1, j_low_box_1,
         #           k_low_box_1, num_cells_1, num_macro_particles_1,
-        #           (, gpu_ID_box_1 if GPU run), hostname_box_1
+        #           (, gpu_ID_box_1 if GPU run), cost_gather_push_box_1,
+        #           cost_deposition_box_1, cost_field_solve_box_1,
+        #           cost_collisions_box_1,
+        #           cost_particle_creation_box_1, hostname_box_1
         #      ...
         #      cost_box_n, proc_box_n, lev_box_n, i_low_box_n, j_low_box_n,
         #           k_low_box_n, num_cells_n, num_macro_particles_n,
-        #           (, gpu_ID_box_n if GPU run), hostname_box_n
+        #           (, gpu_ID_box_n if GPU run), cost_gather_push_box_n,
+        #           cost_deposition_box_n, cost_field_solve_box_n,
+        #           cost_collisions_box_n,
+        #           cost_particle_creation_box_n, hostname_box_n
         i, j, k = (
             data[0, 3::n_data_fields],
             data[0, 4::n_data_fields],
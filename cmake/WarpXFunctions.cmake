@@ -466,6 +466,7 @@ function(warpx_print_summary)
     message("    QED: ${WarpX_QED}")
     message("    QED table generation: ${WarpX_QED_TABLE_GEN}")
     message("    QED tools: ${WarpX_QED_TOOLS}")
+    message("    benchmarks: ${WarpX_BENCHMARKS}")
     message("    SENSEI: ${WarpX_SENSEI}")
     message("")
 endfunction()